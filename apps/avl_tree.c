@@ -0,0 +1,81 @@
+/**
+ * @file avl_tree.c
+ * @author HN Thap
+ * @brief Command line front end of the AVL tree.
+ * 
+ * Just run to see the visualized AVL tree:
+ * 
+ * avl_tree 10 3 10 2 1 -100 4 95 3 489 78
+ * 
+ * in which
+ *      avl_tree is the executable,
+ *      10 is the array size,
+ *      and 3, 10, ..., 78 is the 10-element array that need to be stored.
+ * 
+ * Expected output:
+ * 
+ *              489
+ *         95
+ *             78
+ *     10
+ *         4
+ *             3
+ * 3
+ *         2
+ *     1
+ *         -100
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "avl_tree.h"
+
+int main(int argc, char *argv[])
+{
+    int i, n, rc;
+    AVLNode *root = NULL, *temp;
+    rc = 0;
+    if (argc == 1)
+    {
+        fprintf(stderr, "Invalid arguments: Array size must be specified.\n");
+        return 1;
+    }
+    n = atoi(argv[1]);
+    if (n <= 0)
+    {
+        return 0;
+    }
+    if (argc != n + 2)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Array was expected to have %d element(s), "
+            "but got %d instead.\n",
+            n,
+            argc - 2
+        );
+        return 1;
+    }
+    for (i = 0; i < n; i += 1)
+    {
+        temp = insert_avl(root, atoi(argv[i + 2]));
+        if (temp == NULL)
+        {
+            fprintf(stderr, "Failed to insert into AVL tree: allocation failure.\n");
+            rc = 1;
+            goto cleanup_main;
+        }
+        root = temp;
+    }
+    print_avl_sideways(root, 0);
+    printf("\n");
+cleanup_main:
+    destroy_avl(root);
+    root = NULL; /* Defensive programming */
+    return rc;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file concurrent_bst.c
+ * @author HN Thap
+ * @brief Command line front end of the concurrent BST: a lookup throughput
+ * test under concurrent writes.
+ * 
+ * Just run:
+ * 
+ * concurrent_bst 4 1000000
+ * 
+ * in which
+ *      concurrent_bst is the executable,
+ *      4 is the number of reader threads,
+ *      and 1000000 is the number of keys.
+ * 
+ * The even numbers below twice the number of keys are pushed in random
+ * order. Then every reader thread searches as many random numbers of the
+ * same range (half of them are found), while one writer thread keeps popping
+ * and pushing back random keys. Run it with 1, 2, 4, ... readers to see the
+ * lookups scale with the cores.
+ * 
+ * Expected output (timings vary):
+ * 
+ * 4 reader(s), 1000000 keys: 0.8 million lookups/s, 2001073 found, 91466 writes
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+/* Needed for POSIX threads and clocks under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "concurrent_bst.h"
+
+/**
+ * @brief Maximum number of reader threads.
+ */
+#define CDSA_CONCURRENT_BST_MAX_THREADS (256)
+
+typedef struct Worker
+{
+    ConcurrentBST *set;
+    ConcurrentBSTReader *reader;
+    unsigned long seed;
+    int keys;
+    unsigned long found; /* Reader: keys found, writer: pops and pushes */
+    volatile int *stop; /* Writer only: set when the readers are done */
+} Worker;
+
+/* xorshift32 */
+static unsigned long next_random(unsigned long *state_ref)
+{
+    unsigned long x = *state_ref;
+    x ^= (x << 13) & 0xFFFFFFFFul;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFul;
+    *state_ref = x;
+    return x;
+}
+
+static double now_seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void *read_keys(void *arg)
+{
+    Worker *worker = arg;
+    int i, key;
+    for (i = 0; i < worker->keys; i++)
+    {
+        key = (int)(next_random(&worker->seed) % (2ul * worker->keys));
+        if (
+            search_concurrent_bst(worker->reader, key)
+                == CDSA_CONCURRENT_BST_OK
+        )
+        {
+            worker->found += 1;
+        }
+    }
+    return NULL;
+}
+
+static void *write_keys(void *arg)
+{
+    Worker *worker = arg;
+    int key;
+    while (!*worker->stop)
+    {
+        key = (int)(next_random(&worker->seed) % worker->keys) * 2;
+        /* Both steps only fail if out of memory, and are retried then. */
+        while (
+            pop_concurrent_bst(worker->set, key)
+                == CDSA_CONCURRENT_BST_ALLOC_FAILED
+        )
+        {
+        }
+        while (
+            push_concurrent_bst(worker->set, key)
+                == CDSA_CONCURRENT_BST_ALLOC_FAILED
+        )
+        {
+        }
+        worker->found += 2;
+    }
+    return NULL;
+}
+
+static int safe_atoi(char *s, int *result_ref)
+{
+    long t;
+    char *end;
+    t = strtol(s, &end, 10);
+    if (*end != '\0' || t < INT_MIN || t > INT_MAX)
+    {
+        return CDSA_CONCURRENT_BST_FAILED;
+    }
+    *result_ref = (int)t;
+    return CDSA_CONCURRENT_BST_OK;
+}
+
+int main(int argc, char *argv[])
+{
+    Worker workers[CDSA_CONCURRENT_BST_MAX_THREADS];
+    pthread_t threads[CDSA_CONCURRENT_BST_MAX_THREADS];
+    Worker writer;
+    pthread_t writer_thread;
+    ConcurrentBST *set;
+    ConcurrentBSTReader *reader = NULL;
+    int *keys = NULL;
+    int i, j, n, num_threads, started = 0, rc = 0, temp;
+    volatile int stop = 0;
+    unsigned long seed = 2463534242ul, found = 0;
+    double seconds;
+    if (argc != 3)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Expected %s <threads> <keys>.\n",
+            argv[0]
+        );
+        return 1;
+    }
+    if (safe_atoi(argv[1], &num_threads) != CDSA_CONCURRENT_BST_OK
+        || num_threads <= 0 || num_threads > CDSA_CONCURRENT_BST_MAX_THREADS)
+    {
+        fprintf(
+            stderr,
+            "Invalid number of threads (1 to %d): %s\n",
+            CDSA_CONCURRENT_BST_MAX_THREADS,
+            argv[1]
+        );
+        return 1;
+    }
+    if (safe_atoi(argv[2], &n) != CDSA_CONCURRENT_BST_OK
+        || n <= 0 || n > INT_MAX / 2)
+    {
+        fprintf(stderr, "Invalid number of keys: %s\n", argv[2]);
+        return 1;
+    }
+    set = new_concurrent_bst();
+    keys = malloc((size_t)n * sizeof(int));
+    if (set == NULL || keys == NULL)
+    {
+        fprintf(stderr, "Critical error: allocation failed.\n");
+        rc = 1;
+        goto cleanup_main;
+    }
+    /* Shuffled, so that the unbalanced tree stays shallow. */
+    for (i = 0; i < n; i++) keys[i] = i * 2;
+    for (i = n - 1; i > 0; i--)
+    {
+        j = (int)(next_random(&seed) % (unsigned long)(i + 1));
+        temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (push_concurrent_bst(set, keys[i]) != CDSA_CONCURRENT_BST_OK)
+        {
+            fprintf(stderr, "Failed to insert: allocation failure.\n");
+            rc = 1;
+            goto cleanup_main;
+        }
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        workers[i].set = set;
+        workers[i].reader = attach_concurrent_bst_reader(set);
+        workers[i].seed = seed + (unsigned long)i * 7919ul;
+        workers[i].keys = n;
+        workers[i].found = 0;
+        workers[i].stop = NULL;
+        if (workers[i].reader == NULL)
+        {
+            fprintf(stderr, "Critical error: allocation failed.\n");
+            rc = 1;
+            goto cleanup_main;
+        }
+    }
+    writer.set = set;
+    writer.reader = NULL;
+    writer.seed = seed ^ 0x5bd1e995ul;
+    writer.keys = n;
+    writer.found = 0;
+    writer.stop = &stop;
+    seconds = now_seconds();
+    if (pthread_create(&writer_thread, NULL, write_keys, &writer) != 0)
+    {
+        fprintf(stderr, "Critical error: failed to start a thread.\n");
+        rc = 1;
+        goto cleanup_main;
+    }
+    for (started = 0; started < num_threads; started++)
+    {
+        if (pthread_create(
+            &threads[started],
+            NULL,
+            read_keys,
+            &workers[started]
+        ) != 0)
+        {
+            fprintf(stderr, "Critical error: failed to start a thread.\n");
+            rc = 1;
+            break;
+        }
+    }
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(threads[i], NULL);
+        found += workers[i].found;
+    }
+    seconds = now_seconds() - seconds;
+    stop = 1;
+    (void)pthread_join(writer_thread, NULL);
+    if (rc != 0) goto cleanup_main;
+    printf(
+        "%d reader(s), %d keys: %.1f million lookups/s, %lu found, "
+        "%lu writes\n",
+        num_threads,
+        n,
+        (double)num_threads * n / seconds * 1e-6,
+        found,
+        writer.found
+    );
+    /* Every popped key has been pushed back. */
+    reader = workers[0].reader;
+    for (i = 0; i < n; i++)
+    {
+        if (search_concurrent_bst(reader, i * 2) != CDSA_CONCURRENT_BST_OK
+            || search_concurrent_bst(reader, i * 2 + 1)
+                != CDSA_CONCURRENT_BST_NOT_FOUND)
+        {
+            fprintf(stderr, "Corrupted tree around key %d.\n", i * 2);
+            rc = 1;
+            break;
+        }
+    }
+cleanup_main:
+    free(keys);
+    /* Also frees the readers. The tree may be NULL here. */
+    (void)destroy_concurrent_bst(&set);
+    return rc;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file partial_sort.c
+ * @author HN Thap
+ * @brief Command line front end of partial_sort().
+ * 
+ * This program not just serves as a usage example, it also support command
+ * line arguments. Just run:
+ * 
+ * partial_sort 2 4 3 10 2 1
+ * 
+ * in which partial_sort is the executable, 2 is the number of smallest
+ * elements to sort, 4 is the array size, and 3, 10, 2, 1 is the 4-element
+ * array. The k smallest elements are printed in order.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "partial_sort.h"
+
+int main(int argc, char *argv[])
+{
+    int i, k, n;
+    int *a;
+    if (argc < 3)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: k and array size must be specified.\n"
+        );
+        return 1;
+    }
+    k = atoi(argv[1]);
+    n = atoi(argv[2]);
+    if (n <= 0 || k <= 0)
+    {
+        /* Nothing to print. */
+        return 0;
+    }
+    if (argc != n + 3)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Array elements must be listed in full.\n"
+        );
+        return 1;
+    }
+    a = malloc(n * sizeof(int));
+    if (a == NULL)
+    {
+        fprintf(stderr, "Failed to allocate array. Exiting.\n");
+        return 1;
+    }
+    for (i = 0; i < n; i += 1)
+    {
+        a[i] = atoi(argv[i + 3]);
+    }
+    if (k > n) k = n;
+    partial_sort(n, a, k);
+    for (i = 0; i < k; i += 1)
+    {
+        printf("%d ", a[i]);
+    }
+    printf("\n");
+    free(a);
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file radix_sort.c
+ * @author HN Thap
+ * @brief Command line front end of radix_sort().
+ * 
+ * This program not just serves as a usage example, it also support command
+ * line arguments. Just run:
+ * 
+ * radix_sort 4 3 10 2 1
+ * 
+ * in which radix_sort is the executable, 4 is the array size, and 3, 10,
+ * 2, 1 is the 4-element array that need to be sorted.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "radix_sort.h"
+
+int main(int argc, char *argv[])
+{
+    int i, n;
+    int *a;
+    if (argc == 1)
+    {
+        fprintf(stderr, "Invalid arguments: Array size must be specified.\n");
+        return 1;
+    }
+    n = atoi(argv[1]);
+    if (n <= 0)
+    {
+        /* An empty array is sorted by nature. */
+        return 0;
+    }
+    if (argc != n + 2)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Array elements must be listed in full.\n"
+        );
+        return 1;
+    }
+    a = malloc(n * sizeof(int));
+    if (a == NULL)
+    {
+        fprintf(stderr, "Failed to allocate array. Exiting.\n");
+        return 1;
+    }
+    for (i = 0; i < n; i += 1)
+    {
+        a[i] = atoi(argv[i + 2]);
+    }
+    radix_sort(n, a);
+    for (i = 0; i < n; i += 1)
+    {
+        printf("%d ", a[i]);
+    }
+    printf("\n");
+    free(a);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file simple_bst.c
+ * @author HN Thap
+ * @brief Command line front end of the simple BST.
+ * 
+ * Just run to see the visualized tree:
+ * 
+ * simple_bst 10 3 10 2 1 -100 4 95 3 489 78
+ * 
+ * in which
+ *      simple_bst is the executable,
+ *      10 is the array size,
+ *      and 3, 10, ..., 78 is the 10-element array that need to be stored.
+ * 
+ * Expected output:
+ * 
+ *             489
+ *         95
+ *             78
+ *     10
+ *         4
+ * 3
+ *         3
+ *     2
+ *         1
+ *             -100
+ * 
+ * @version 0.1
+ * @date 2025-08-11
+ * @copyright See LICENSE
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simple_bst.h"
+
+static int safe_atoi(char *s, int *result_ref)
+{
+    long t;
+    char *end;
+    t = strtol(s, &end, 10);
+    if (*end != '\0' || t < INT_MIN || t > INT_MAX)
+    {
+        return CDSA_SIMPLE_BST_FAILED;
+    }
+    *result_ref = (int)t;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int main(int argc, char *argv[])
+{
+    int i, n, rc, temp;
+    BST *tree;
+    rc = 0;
+    if (argc == 1)
+    {
+        fprintf(stderr, "Invalid arguments: Array size must be specified.\n");
+        return 1;
+    }
+    if (safe_atoi(argv[1], &n) != CDSA_SIMPLE_BST_OK)
+    {
+        fprintf(stderr, "Invalid array size: %s\n", argv[1]);
+        return 1;
+    }
+    if (n <= 0)
+    {
+        return 0;
+    }
+    if (argc != n + 2)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Array was expected to have %d element(s), "
+            "but got %d instead.\n",
+            n,
+            argc - 2
+        );
+        return 1;
+    }
+    tree = new_bst();
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Critical error: allocation failed.\n");
+        return 1;
+    }
+    for (i = 0; i < n; i += 1)
+    {
+        if (safe_atoi(argv[i + 2], &temp) != CDSA_SIMPLE_BST_OK)
+        {
+            fprintf(
+                stderr,
+                "Invalid value at index %d: %s\n",
+                i + 2,
+                argv[i + 2]
+            );
+            rc = 1;
+            goto cleanup_main;
+        }
+        if (push_bst(tree, temp) != CDSA_SIMPLE_BST_OK)
+        {
+            fprintf(stderr, "Failed to insert into BST: allocation failure.\n");
+            rc = 1;
+            goto cleanup_main;
+        }
+    }
+    /* NULL check for tree has already been performed,
+     * so print_bst_sideways() cannot fail. */
+    (void)print_bst_sideways(tree);
+    printf("\n");
+cleanup_main:
+    /* NULL check for tree has already been performed,
+     * so destroy_bst() cannot fail. */
+    (void)destroy_bst(&tree);
+    tree = NULL; /* Defensive programming */
+    return rc;
+}
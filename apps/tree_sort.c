@@ -0,0 +1,124 @@
+/**
+ * @file tree_sort.c
+ * @author HN Thap
+ * @brief Command line front end of tree_sort().
+ * 
+ * This program not just serves as a usage example, it also support command
+ * line arguments. Just run:
+ * 
+ * tree_sort 4 3 10 2 1
+ * 
+ * in which tree_sort is the executable, 4 is the array size, and 3, 10,
+ * 2, 1 is the 4-element array that need to be sorted.
+ * 
+ * To sort a whole file, of any size, into another one, run:
+ * 
+ * tree_sort --binary input.bin output.bin
+ * tree_sort --text input.txt output.txt
+ * 
+ * Binary files hold raw native-endian ints and are memory-mapped, text files
+ * hold decimal ints separated by whitespace and are written one per line.
+ * Either path can be "-" for the standard input or output, so that the
+ * program can serve as a pipeline stage. Files are sorted with the AVL
+ * backend (tree_sort_with_backend()), which stays O(n log n) on files that are
+ * already sorted.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sort_io.h"
+#include "tree_sort.h"
+
+/* Sort a whole file into another of the same format, "-" being the
+ * standard input or output. */
+static int sort_file(
+    int format,
+    const char *input_path,
+    const char *output_path
+)
+{
+    SortIOArray array;
+    int rc;
+    if (sort_io_read(input_path, format, &array) != CDSA_SORT_IO_OK) return 1;
+    rc = 0;
+    /* An empty array is sorted by nature, and may have no data at all. */
+    if (array.count > 1)
+    {
+        rc = tree_sort_with_backend(
+            array.count,
+            array.data,
+            CDSA_TREE_SORT_BACKEND_AVL
+        ) != CDSA_TREE_SORT_OK;
+    }
+    if (rc == 0)
+    {
+        rc = sort_io_write(output_path, format, array.count, array.data)
+            != CDSA_SORT_IO_OK;
+    }
+    sort_io_release(&array);
+    return rc;
+}
+
+int main(int argc, char *argv[])
+{
+    int i, n, format;
+    int *a;
+    if (argc == 1)
+    {
+        fprintf(stderr, "Invalid arguments: Array size must be specified.\n");
+        return 1;
+    }
+    if (sort_io_parse_format(argv[1], &format) == CDSA_SORT_IO_OK)
+    {
+        if (argc != 4)
+        {
+            fprintf(
+                stderr,
+                "Invalid arguments: Expected %s <input> <output>.\n",
+                argv[1]
+            );
+            return 1;
+        }
+        return sort_file(format, argv[2], argv[3]);
+    }
+    n = atoi(argv[1]);
+    if (n <= 0)
+    {
+        /* An empty array is sorted by nature. */
+        return 0;
+    }
+    if (argc != n + 2)
+    {
+        fprintf(
+            stderr,
+            "Invalid arguments: Array was expected to have %d element(s), "
+            "but got %d instead.\n",
+            n,
+            argc - 2
+        );
+        return 1;
+    }
+    a = malloc(n * sizeof(int));
+    if (a == NULL)
+    {
+        fprintf(stderr, "Failed to allocate array. Exiting.\n");
+        return 1;
+    }
+    for (i = 0; i < n; i += 1)
+    {
+        a[i] = atoi(argv[i + 2]);
+    }
+    tree_sort(n, a);
+    for (i = 0; i < n; i += 1)
+    {
+        printf("%d ", a[i]);
+    }
+    printf("\n");
+    free(a);
+    return 0;
+}
@@ -0,0 +1,1109 @@
+/**
+ * @file bench.c
+ * @author HN Thap
+ * @brief Benchmark harness for the sorters and trees of this project.
+ * 
+ * The harness is built once per module, so that only that module's
+ * allocations are counted: compiling with -DCDSA_BENCH_TARGET_<module>
+ * (e.g. -DCDSA_BENCH_TARGET_merge_sort) and -Iinclude includes
+ * ../src/<module>.c (and ../src/avl_tree.c and ../src/b_plus_tree.c for the
+ * tree sorts, whose AVL and B+ backends live there) and the adapters of its
+ * functions. `make bench` builds and runs all of them.
+ * 
+ * Each function is run over generated distributions (random, sorted,
+ * reverse, organ_pipe, few_unique, nearly_sorted) of 1e2 to 1e8 ints, one
+ * row per function, distribution and size:
+ * 
+ * module,function,distribution,size,repeats,ns_per_element,allocations,
+ * allocated_bytes,peak_heap_bytes,peak_rss_kb,status
+ * 
+ * Short runs are repeated until they take CDSA_BENCH_MIN_SECONDS in total,
+ * and ns_per_element is their average. The allocation columns count the
+ * calls to malloc(), calloc() and realloc() made by the module during one
+ * run, the bytes they requested, and the peak of the bytes live at once.
+ * peak_rss_kb is the peak resident set size of the whole process so far;
+ * run a single function, distribution and size per process for a per-run
+ * figure. The status is ok, failed (wrong result) or skipped: unbalanced
+ * trees are not run on the distributions that make them quadratic above
+ * CDSA_BENCH_DEGENERATE_MAX_SIZE elements.
+ * 
+ * Usage:
+ * 
+ * bench_merge_sort [--format csv|json] [--no-header] [--min-size N]
+ *                  [--max-size N] [--size N] [--distribution NAME]
+ *                  [--function NAME] [--seed N]
+ * 
+ * With --format json, every row is printed as one JSON object per line
+ * (JSON Lines), so the output of several runs can simply be concatenated.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+/* Needed for POSIX clocks and resource usage under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+#define _XOPEN_SOURCE 600
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Runs shorter than this are repeated (in seconds).
+ */
+#define CDSA_BENCH_MIN_SECONDS (0.25)
+
+/**
+ * @brief Maximum number of repeats of a run.
+ */
+#define CDSA_BENCH_MAX_REPEATS (1000)
+
+/**
+ * @brief Default size range (sizes are powers of 10 in between).
+ */
+#define CDSA_BENCH_MIN_SIZE (100)
+#define CDSA_BENCH_MAX_SIZE (100000000)
+
+/**
+ * @brief Unbalanced trees are skipped above this size on the distributions
+ * that degenerate them into lists.
+ */
+#define CDSA_BENCH_DEGENERATE_MAX_SIZE (10000)
+
+/**
+ * @brief Maximum number of timed phases of one function (e.g. push, search
+ * and pop of a tree).
+ */
+#define CDSA_BENCH_MAX_PHASES (3)
+
+/**
+ * @brief Number of threads given to parallel functions.
+ */
+#define CDSA_BENCH_THREADS (4)
+
+/**
+ * @brief Number of smallest elements asked from partial sorts.
+ */
+#define CDSA_BENCH_TOP_K(n) ((n) / 100 + 1)
+
+/**
+ * @brief Distributions of the generated input.
+ */
+#define CDSA_BENCH_RANDOM (0)
+#define CDSA_BENCH_SORTED (1)
+#define CDSA_BENCH_REVERSE (2)
+#define CDSA_BENCH_ORGAN_PIPE (3)
+#define CDSA_BENCH_FEW_UNIQUE (4)
+#define CDSA_BENCH_NEARLY_SORTED (5)
+#define CDSA_BENCH_DISTRIBUTIONS (6)
+
+/**
+ * @brief Bit mask of a distribution, see BenchFunction.
+ */
+#define CDSA_BENCH_MASK(distribution) (1u << (distribution))
+
+/**
+ * @brief Distributions on which a plain BST degenerates into a list.
+ */
+#define CDSA_BENCH_PRESORTED \
+    (CDSA_BENCH_MASK(CDSA_BENCH_SORTED) \
+    | CDSA_BENCH_MASK(CDSA_BENCH_REVERSE) \
+    | CDSA_BENCH_MASK(CDSA_BENCH_ORGAN_PIPE) \
+    | CDSA_BENCH_MASK(CDSA_BENCH_NEARLY_SORTED))
+
+/**
+ * @brief Output formats.
+ */
+#define CDSA_BENCH_FORMAT_CSV (0)
+#define CDSA_BENCH_FORMAT_JSON (1)
+
+/**
+ * @brief Allocation counters, updated by the wrappers the module is
+ * compiled against.
+ */
+typedef struct BenchAllocStats
+{
+    unsigned long allocations;
+    size_t allocated_bytes;
+    size_t live_bytes;
+    size_t peak_bytes;
+} BenchAllocStats;
+
+/**
+ * @brief Header in front of every counted block, aligned for any type.
+ */
+typedef union BenchAllocHeader
+{
+    size_t size;
+    long double align_long_double;
+    void *align_pointer;
+    long align_long;
+} BenchAllocHeader;
+
+/**
+ * @brief Measurements of one timed phase.
+ */
+typedef struct BenchPhase
+{
+    double seconds; /* Total over all repeats */
+    double started;
+    BenchAllocStats at_start;
+    unsigned long allocations; /* The rest is measured on the first run */
+    size_t allocated_bytes;
+    size_t peak_heap_bytes;
+} BenchPhase;
+
+/**
+ * @brief State of one run (function, distribution and size).
+ */
+typedef struct BenchRun
+{
+    int repeat;
+    BenchPhase phases[CDSA_BENCH_MAX_PHASES];
+} BenchRun;
+
+/**
+ * @brief A benchmarked function. run() gets a copy of the input, and times
+ * its phases with bench_begin() and bench_end(). It returns non-zero when
+ * the result is wrong. For sorts (is_sort), the harness checks the result.
+ */
+typedef struct BenchFunction
+{
+    int (*run)(BenchRun *run, int *arr, int n);
+    int is_sort;
+    unsigned int degenerate; /* Mask of distributions that are quadratic */
+    int phase_count;
+    const char *phases[CDSA_BENCH_MAX_PHASES]; /* Function names */
+} BenchFunction;
+
+static BenchAllocStats bench_alloc;
+
+static void *bench_malloc(size_t size);
+static void *bench_calloc(size_t count, size_t size);
+static void *bench_realloc(void *block, size_t size);
+static void bench_free(void *block);
+
+/**
+ * @brief Start timing a phase (and counting allocations on the first run).
+ */
+static void bench_begin(BenchRun *run, int phase);
+
+/**
+ * @brief Stop timing a phase.
+ */
+static void bench_end(BenchRun *run, int phase);
+
+/*
+ * The module under test: its allocations go through the counting wrappers.
+ */
+#define malloc(size) bench_malloc(size)
+#define calloc(count, size) bench_calloc(count, size)
+#define realloc(block, size) bench_realloc(block, size)
+#define free(block) bench_free(block)
+
+#if defined(CDSA_BENCH_TARGET_merge_sort)
+#include "../src/merge_sort.c"
+#elif defined(CDSA_BENCH_TARGET_tree_sort)
+#include "../src/avl_tree.c"
+#include "../src/b_plus_tree.c"
+#include "../src/tree_sort.c"
+#elif defined(CDSA_BENCH_TARGET_radix_sort)
+#include "../src/radix_sort.c"
+#elif defined(CDSA_BENCH_TARGET_partial_sort)
+#include "../src/partial_sort.c"
+#elif defined(CDSA_BENCH_TARGET_simple_bst)
+#include "../src/simple_bst.c"
+#elif defined(CDSA_BENCH_TARGET_avl_tree)
+#include "../src/avl_tree.c"
+#elif defined(CDSA_BENCH_TARGET_b_plus_tree)
+#include "../src/b_plus_tree.c"
+#else
+#error "Define CDSA_BENCH_TARGET_<module> to choose the benchmarked module."
+#endif
+
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+
+#if defined(CDSA_BENCH_TARGET_partial_sort) \
+    || defined(CDSA_BENCH_TARGET_tree_sort)
+/*
+ * Whether arr[0, k) is sorted and holds the k smallest elements of arr
+ * (the permutation itself is not checked).
+ */
+static int bench_is_partially_sorted(const int *arr, int n, int k)
+{
+    int i;
+    for (i = 1; i < k; i++)
+    {
+        if (arr[i - 1] > arr[i]) return 0;
+    }
+    for (i = k; i < n; i++)
+    {
+        if (arr[i] < arr[k - 1]) return 0;
+    }
+    return 1;
+}
+#endif
+
+#if defined(CDSA_BENCH_TARGET_merge_sort)
+#define CDSA_BENCH_MODULE "merge_sort"
+
+static int bench_merge_sort(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    merge_sort(n, arr);
+    bench_end(run, 0);
+    return 0;
+}
+
+static int bench_merge_sort_bottom_up(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    merge_sort_bottom_up(n, arr);
+    bench_end(run, 0);
+    return 0;
+}
+
+static int bench_merge_sort_natural(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    merge_sort_natural(n, arr);
+    bench_end(run, 0);
+    return 0;
+}
+
+static int bench_merge_sort_in_place(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    merge_sort_in_place(n, arr);
+    bench_end(run, 0);
+    return 0;
+}
+
+/* Sorts the input with an int payload holding the original positions, and
+ * checks that equal keys kept their order. */
+static int bench_merge_sort_by_key(BenchRun *run, int *arr, int n)
+{
+    int *payload;
+    int i, rc;
+    payload = malloc(n * sizeof(int));
+    if (payload == NULL) return 1;
+    for (i = 0; i < n; i++) payload[i] = i;
+    bench_begin(run, 0);
+    rc = merge_sort_by_key(n, arr, payload, sizeof(int));
+    bench_end(run, 0);
+    for (i = 1; rc == CDSA_MERGE_SORT_OK && i < n; i++)
+    {
+        if (arr[i - 1] == arr[i] && payload[i - 1] > payload[i]) rc = 1;
+    }
+    free(payload);
+    return rc != CDSA_MERGE_SORT_OK;
+}
+
+static const BenchFunction bench_functions[] = {
+    {bench_merge_sort, 1, 0, 1, {"merge_sort", NULL, NULL}},
+    {bench_merge_sort_bottom_up, 1, 0, 1, {"merge_sort_bottom_up", NULL, NULL}},
+    {bench_merge_sort_natural, 1, 0, 1, {"merge_sort_natural", NULL, NULL}},
+    {bench_merge_sort_in_place, 1, 0, 1, {"merge_sort_in_place", NULL, NULL}},
+    {bench_merge_sort_by_key, 1, 0, 1, {"merge_sort_by_key", NULL, NULL}}
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_tree_sort)
+#define CDSA_BENCH_MODULE "tree_sort"
+
+static int bench_tree_sort_bst(BenchRun *run, int *arr, int n)
+{
+    int rc;
+    bench_begin(run, 0);
+    rc = tree_sort_bst(n, arr);
+    bench_end(run, 0);
+    return rc != CDSA_TREE_SORT_OK;
+}
+
+static int bench_tree_sort_avl(BenchRun *run, int *arr, int n)
+{
+    int rc;
+    bench_begin(run, 0);
+    rc = tree_sort_avl(n, arr);
+    bench_end(run, 0);
+    return rc != CDSA_TREE_SORT_OK;
+}
+
+static int bench_tree_sort_bplus(BenchRun *run, int *arr, int n)
+{
+    int rc;
+    bench_begin(run, 0);
+    rc = tree_sort_bplus(n, arr);
+    bench_end(run, 0);
+    return rc != CDSA_TREE_SORT_OK;
+}
+
+static int bench_tree_sort_partial(BenchRun *run, int *arr, int n)
+{
+    int rc;
+    int k = CDSA_BENCH_TOP_K(n);
+    bench_begin(run, 0);
+    rc = tree_sort_partial(n, arr, k);
+    bench_end(run, 0);
+    return rc != CDSA_TREE_SORT_OK || !bench_is_partially_sorted(arr, n, k);
+}
+
+static const BenchFunction bench_functions[] = {
+    /* Equal keys share a node, so only presorted input degenerates */
+    {
+        bench_tree_sort_bst,
+        1,
+        CDSA_BENCH_PRESORTED,
+        1,
+        {"tree_sort_bst", NULL, NULL}
+    },
+    {bench_tree_sort_avl, 1, 0, 1, {"tree_sort_avl", NULL, NULL}},
+    {bench_tree_sort_bplus, 1, 0, 1, {"tree_sort_bplus", NULL, NULL}},
+    /* The first k keys of presorted input form a chain */
+    {
+        bench_tree_sort_partial,
+        0,
+        CDSA_BENCH_PRESORTED,
+        1,
+        {"tree_sort_partial", NULL, NULL}
+    }
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_radix_sort)
+#define CDSA_BENCH_MODULE "radix_sort"
+
+static int bench_radix_sort(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    radix_sort(n, arr);
+    bench_end(run, 0);
+    return 0;
+}
+
+static int bench_radix_sort_parallel(BenchRun *run, int *arr, int n)
+{
+    bench_begin(run, 0);
+    radix_sort_parallel(n, arr, CDSA_BENCH_THREADS);
+    bench_end(run, 0);
+    return 0;
+}
+
+static const BenchFunction bench_functions[] = {
+    {bench_radix_sort, 1, 0, 1, {"radix_sort", NULL, NULL}},
+    {bench_radix_sort_parallel, 1, 0, 1, {"radix_sort_parallel", NULL, NULL}}
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_partial_sort)
+#define CDSA_BENCH_MODULE "partial_sort"
+
+static int bench_partial_sort(BenchRun *run, int *arr, int n)
+{
+    int k = CDSA_BENCH_TOP_K(n);
+    bench_begin(run, 0);
+    partial_sort(n, arr, k);
+    bench_end(run, 0);
+    return !bench_is_partially_sorted(arr, n, k);
+}
+
+static int bench_partial_sort_nth_element(BenchRun *run, int *arr, int n)
+{
+    int nth = n / 2;
+    int i, failed = 0;
+    bench_begin(run, 0);
+    partial_sort_nth_element(n, arr, nth);
+    bench_end(run, 0);
+    for (i = 0; i < n; i++)
+    {
+        failed |= (i < nth) ? arr[i] > arr[nth] : arr[i] < arr[nth];
+    }
+    return failed;
+}
+
+static const BenchFunction bench_functions[] = {
+    {bench_partial_sort, 0, 0, 1, {"partial_sort", NULL, NULL}},
+    {
+        bench_partial_sort_nth_element,
+        0,
+        0,
+        1,
+        {"partial_sort_nth_element", NULL, NULL}
+    }
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_simple_bst)
+#define CDSA_BENCH_MODULE "simple_bst"
+
+static int bench_simple_bst(BenchRun *run, int *arr, int n)
+{
+    BST *tree = new_bst();
+    int i, failed = 0;
+    if (tree == NULL) return 1;
+    bench_begin(run, 0);
+    for (i = 0; i < n; i++)
+    {
+        failed |= push_bst(tree, arr[i]) != CDSA_SIMPLE_BST_OK;
+    }
+    bench_end(run, 0);
+    bench_begin(run, 1);
+    for (i = 0; i < n; i++)
+    {
+        failed |= search_bst(tree, arr[i]) != CDSA_SIMPLE_BST_OK;
+    }
+    bench_end(run, 1);
+    bench_begin(run, 2);
+    for (i = 0; i < n; i++)
+    {
+        failed |= pop_bst(tree, arr[i]) != CDSA_SIMPLE_BST_OK;
+    }
+    bench_end(run, 2);
+    failed |= tree->root != NULL;
+    (void)destroy_bst(&tree);
+    return failed;
+}
+
+static int bench_compare_ints(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/* Regression check: build_bst_from_sorted() spreads the 182 copies of 0 on
+ * both sides of each other, and the 251 pushed ones chain past the iterator
+ * depth, so range_bst() resumes among copies of 0 off its search path. */
+static int bench_simple_bst_spread_copies(void)
+{
+    int zeros[182];
+    int out[434];
+    BST *tree;
+    int i, count, failed = 0;
+    for (i = 0; i < 182; i++) zeros[i] = 0;
+    tree = build_bst_from_sorted(zeros, 182);
+    if (tree == NULL) return 1;
+    for (i = 0; i < 251; i++)
+    {
+        failed |= push_bst(tree, 0) != CDSA_SIMPLE_BST_OK;
+    }
+    failed |= range_bst(tree, 0, 0, out, 434, &count) != CDSA_SIMPLE_BST_OK
+        || count != 433;
+    (void)destroy_bst(&tree);
+    return failed;
+}
+
+static int bench_simple_bst_range(BenchRun *run, int *arr, int n)
+{
+    BST *tree;
+    int *out;
+    int count = 0, failed = 0;
+    if (run->repeat == 0) failed |= bench_simple_bst_spread_copies();
+    qsort(arr, n, sizeof(int), bench_compare_ints);
+    out = malloc(n * sizeof(int));
+    if (out == NULL) return 1;
+    bench_begin(run, 0);
+    tree = build_bst_from_sorted(arr, n);
+    bench_end(run, 0);
+    if (tree == NULL)
+    {
+        free(out);
+        return 1;
+    }
+    bench_begin(run, 1);
+    failed |= range_bst(tree, arr[0], arr[n - 1], out, n, &count)
+        != CDSA_SIMPLE_BST_OK;
+    bench_end(run, 1);
+    failed |= count != n || memcmp(out, arr, n * sizeof(int)) != 0;
+    (void)destroy_bst(&tree);
+    free(out);
+    return failed;
+}
+
+static const BenchFunction bench_functions[] = {
+    /* Equal keys are chained to the left, so few_unique degenerates too */
+    {
+        bench_simple_bst,
+        0,
+        CDSA_BENCH_PRESORTED | CDSA_BENCH_MASK(CDSA_BENCH_FEW_UNIQUE),
+        3,
+        {"push_bst", "search_bst", "pop_bst"}
+    },
+    {
+        bench_simple_bst_range,
+        0,
+        0,
+        2,
+        {"build_bst_from_sorted", "range_bst", NULL}
+    }
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_avl_tree)
+#define CDSA_BENCH_MODULE "avl_tree"
+
+static int bench_avl_tree(BenchRun *run, int *arr, int n)
+{
+    AVLNode *root = NULL;
+    AVLNode *temp;
+    int i, failed = 0;
+    bench_begin(run, 0);
+    for (i = 0; i < n; i++)
+    {
+        temp = insert_avl(root, arr[i]);
+        if (temp == NULL)
+        {
+            failed = 1;
+            break;
+        }
+        root = temp;
+    }
+    bench_end(run, 0);
+    bench_begin(run, 1);
+    for (i = 0; i < n; i++)
+    {
+        failed |= search_avl(root, arr[i]) == NULL;
+    }
+    bench_end(run, 1);
+    bench_begin(run, 2);
+    for (i = 0; i < n; i++)
+    {
+        failed |= delete_avl(&root, arr[i]) != CDSA_AVL_TREE_OK;
+    }
+    bench_end(run, 2);
+    failed |= root != NULL;
+    destroy_avl(root);
+    return failed;
+}
+
+static const BenchFunction bench_functions[] = {
+    {bench_avl_tree, 0, 0, 3, {"insert_avl", "search_avl", "delete_avl"}}
+};
+#endif
+
+#if defined(CDSA_BENCH_TARGET_b_plus_tree)
+#define CDSA_BENCH_MODULE "b_plus_tree"
+
+static int bench_b_plus_tree(BenchRun *run, int *arr, int n)
+{
+    BPlusTree *tree = new_bplus_tree();
+    int i, failed = 0;
+    if (tree == NULL) return 1;
+    bench_begin(run, 0);
+    for (i = 0; i < n; i++)
+    {
+        failed |= push_bplus_tree(tree, arr[i]) != CDSA_BPLUS_TREE_OK;
+    }
+    bench_end(run, 0);
+    bench_begin(run, 1);
+    for (i = 0; i < n; i++)
+    {
+        failed |= search_bplus_tree(tree, arr[i]) != CDSA_BPLUS_TREE_OK;
+    }
+    bench_end(run, 1);
+    bench_begin(run, 2);
+    for (i = 0; i < n; i++)
+    {
+        failed |= pop_bplus_tree(tree, arr[i]) != CDSA_BPLUS_TREE_OK;
+    }
+    bench_end(run, 2);
+    failed |= tree->count != 0;
+    (void)destroy_bplus_tree(&tree);
+    return failed;
+}
+
+static const BenchFunction bench_functions[] = {
+    {
+        bench_b_plus_tree,
+        0,
+        0,
+        3,
+        {"push_bplus_tree", "search_bplus_tree", "pop_bplus_tree"}
+    }
+};
+#endif
+
+static const char *const bench_distribution_names[CDSA_BENCH_DISTRIBUTIONS] = {
+    "random",
+    "sorted",
+    "reverse",
+    "organ_pipe",
+    "few_unique",
+    "nearly_sorted"
+};
+
+static unsigned long bench_random_state = 2463534242ul;
+
+static void *bench_malloc(size_t size)
+{
+    BenchAllocHeader *header;
+    if (size > (size_t)-1 - sizeof(BenchAllocHeader)) return NULL;
+    header = malloc(sizeof(BenchAllocHeader) + size);
+    if (header == NULL) return NULL;
+    header->size = size;
+    bench_alloc.allocations += 1;
+    bench_alloc.allocated_bytes += size;
+    bench_alloc.live_bytes += size;
+    if (bench_alloc.live_bytes > bench_alloc.peak_bytes)
+    {
+        bench_alloc.peak_bytes = bench_alloc.live_bytes;
+    }
+    return header + 1;
+}
+
+static void *bench_calloc(size_t count, size_t size)
+{
+    void *block;
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+    block = bench_malloc(count * size);
+    if (block != NULL) memset(block, 0, count * size);
+    return block;
+}
+
+static void *bench_realloc(void *block, size_t size)
+{
+    BenchAllocHeader *header;
+    size_t old_size;
+    if (block == NULL) return bench_malloc(size);
+    if (size > (size_t)-1 - sizeof(BenchAllocHeader)) return NULL;
+    header = (BenchAllocHeader *)block - 1;
+    old_size = header->size;
+    header = realloc(header, sizeof(BenchAllocHeader) + size);
+    if (header == NULL) return NULL;
+    header->size = size;
+    bench_alloc.allocations += 1;
+    bench_alloc.allocated_bytes += size;
+    bench_alloc.live_bytes += size - old_size;
+    if (bench_alloc.live_bytes > bench_alloc.peak_bytes)
+    {
+        bench_alloc.peak_bytes = bench_alloc.live_bytes;
+    }
+    return header + 1;
+}
+
+static void bench_free(void *block)
+{
+    BenchAllocHeader *header;
+    if (block == NULL) return;
+    header = (BenchAllocHeader *)block - 1;
+    bench_alloc.live_bytes -= header->size;
+    free(header);
+}
+
+/**
+ * @brief Monotonic wall-clock time in seconds.
+ */
+static double bench_now(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief Peak resident set size of the process in KiB, -1 if unknown.
+ */
+static long bench_peak_rss_kb(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return -1;
+    }
+    return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; /* Bytes on macOS */
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void bench_begin(BenchRun *run, int phase)
+{
+    BenchPhase *p = &run->phases[phase];
+    if (run->repeat == 0)
+    {
+        bench_alloc.peak_bytes = bench_alloc.live_bytes;
+        p->at_start = bench_alloc;
+    }
+    p->started = bench_now();
+}
+
+static void bench_end(BenchRun *run, int phase)
+{
+    BenchPhase *p = &run->phases[phase];
+    p->seconds += bench_now() - p->started;
+    if (run->repeat == 0)
+    {
+        p->allocations = bench_alloc.allocations - p->at_start.allocations;
+        p->allocated_bytes = bench_alloc.allocated_bytes
+            - p->at_start.allocated_bytes;
+        p->peak_heap_bytes = bench_alloc.peak_bytes - p->at_start.live_bytes;
+    }
+}
+
+/**
+ * @brief xorshift32, so that inputs are the same on every platform.
+ */
+static unsigned long bench_random(void)
+{
+    unsigned long x = bench_random_state;
+    x ^= (x << 13) & 0xFFFFFFFFul;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFul;
+    bench_random_state = x;
+    return x;
+}
+
+static void bench_generate(int *arr, int n, int distribution)
+{
+    unsigned long x;
+    int i, j, k, temp;
+    for (i = 0; i < n; i++)
+    {
+        switch (distribution)
+        {
+        case CDSA_BENCH_RANDOM:
+            /* Any 32-bit value, without relying on unsigned to int */
+            x = bench_random();
+            arr[i] = (int)(x & 0x7FFFFFFFul);
+            if (x & 0x80000000ul) arr[i] = -arr[i] - 1;
+            break;
+        case CDSA_BENCH_REVERSE:
+            arr[i] = n - 1 - i;
+            break;
+        case CDSA_BENCH_ORGAN_PIPE:
+            arr[i] = (i < n / 2) ? i : n - 1 - i;
+            break;
+        case CDSA_BENCH_FEW_UNIQUE:
+            arr[i] = (int)(bench_random() % 16);
+            break;
+        case CDSA_BENCH_SORTED:
+        case CDSA_BENCH_NEARLY_SORTED:
+        default:
+            arr[i] = i;
+            break;
+        }
+    }
+    if (distribution == CDSA_BENCH_NEARLY_SORTED)
+    {
+        /* Swap 1% of the elements with random others */
+        for (k = 0; k < n / 100; k++)
+        {
+            i = (int)(bench_random() % (unsigned long)n);
+            j = (int)(bench_random() % (unsigned long)n);
+            temp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = temp;
+        }
+    }
+}
+
+/**
+ * @brief Order-independent checksum, to check a sort lost no element.
+ */
+static unsigned long bench_checksum(const int *arr, int n)
+{
+    unsigned long sum = 0;
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        sum += (unsigned long)arr[i] * 2654435761ul;
+    }
+    return sum;
+}
+
+static void bench_print_row(
+    int format,
+    const char *function,
+    int distribution,
+    int n,
+    int repeats,
+    const BenchPhase *phase,
+    const char *status
+)
+{
+    double ns = 0.0;
+    if (phase != NULL && repeats > 0)
+    {
+        ns = phase->seconds * 1e9 / ((double)repeats * (double)n);
+    }
+    if (format == CDSA_BENCH_FORMAT_JSON)
+    {
+        printf(
+            "{\"module\":\"%s\",\"function\":\"%s\",\"distribution\":\"%s\","
+            "\"size\":%d,\"repeats\":%d,\"ns_per_element\":%.3f,"
+            "\"allocations\":%lu,\"allocated_bytes\":%lu,"
+            "\"peak_heap_bytes\":%lu,\"peak_rss_kb\":%ld,\"status\":\"%s\"}\n",
+            CDSA_BENCH_MODULE,
+            function,
+            bench_distribution_names[distribution],
+            n,
+            repeats,
+            ns,
+            phase ? phase->allocations : 0ul,
+            phase ? (unsigned long)phase->allocated_bytes : 0ul,
+            phase ? (unsigned long)phase->peak_heap_bytes : 0ul,
+            bench_peak_rss_kb(),
+            status
+        );
+    }
+    else
+    {
+        printf(
+            "%s,%s,%s,%d,%d,%.3f,%lu,%lu,%lu,%ld,%s\n",
+            CDSA_BENCH_MODULE,
+            function,
+            bench_distribution_names[distribution],
+            n,
+            repeats,
+            ns,
+            phase ? phase->allocations : 0ul,
+            phase ? (unsigned long)phase->allocated_bytes : 0ul,
+            phase ? (unsigned long)phase->peak_heap_bytes : 0ul,
+            bench_peak_rss_kb(),
+            status
+        );
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Run one function over one input, and print one row per phase.
+ */
+static void bench_run(
+    const BenchFunction *function,
+    const int *input,
+    int *work,
+    int n,
+    int distribution,
+    int format
+)
+{
+    BenchRun run;
+    unsigned long checksum = 0;
+    double total;
+    int i, p, failed = 0;
+    memset(&run, 0, sizeof(run));
+    if (function->is_sort) checksum = bench_checksum(input, n);
+    do
+    {
+        memcpy(work, input, n * sizeof(int));
+        failed |= function->run(&run, work, n);
+        if (function->is_sort && run.repeat == 0)
+        {
+            for (i = 1; i < n; i++)
+            {
+                if (work[i - 1] > work[i]) break;
+            }
+            failed |= i < n || bench_checksum(work, n) != checksum;
+        }
+        run.repeat += 1;
+        total = 0.0;
+        for (p = 0; p < function->phase_count; p++)
+        {
+            total += run.phases[p].seconds;
+        }
+    } while (total < CDSA_BENCH_MIN_SECONDS
+        && run.repeat < CDSA_BENCH_MAX_REPEATS);
+    for (p = 0; p < function->phase_count; p++)
+    {
+        bench_print_row(
+            format,
+            function->phases[p],
+            distribution,
+            n,
+            run.repeat,
+            &run.phases[p],
+            failed ? "failed" : "ok"
+        );
+    }
+}
+
+static int bench_parse_size(const char *s, int *size_ref)
+{
+    char *end;
+    double value = strtod(s, &end); /* Accepts 1e6 as well */
+    if (end == s || *end != '\0' || value < 1.0 || value > (double)INT_MAX)
+    {
+        fprintf(stderr, "Invalid arguments: bad size \"%s\".\n", s);
+        return 0;
+    }
+    *size_ref = (int)value;
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    const int function_count =
+        (int)(sizeof(bench_functions) / sizeof(bench_functions[0]));
+    const char *only_function = NULL;
+    int only_distribution = -1;
+    int min_size = CDSA_BENCH_MIN_SIZE;
+    int max_size = CDSA_BENCH_MAX_SIZE;
+    int format = CDSA_BENCH_FORMAT_CSV;
+    int header = 1;
+    int *input = NULL, *work = NULL;
+    int i, f, p, d, n;
+    unsigned long seed = bench_random_state;
+    /* Not every module calls them */
+    (void)bench_calloc;
+    (void)bench_realloc;
+    (void)bench_free;
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--no-header") == 0)
+        {
+            header = 0;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--format") == 0)
+        {
+            i += 1;
+            if (strcmp(argv[i], "json") == 0)
+            {
+                format = CDSA_BENCH_FORMAT_JSON;
+            }
+            else if (strcmp(argv[i], "csv") == 0)
+            {
+                format = CDSA_BENCH_FORMAT_CSV;
+            }
+            else
+            {
+                fprintf(stderr, "Invalid arguments: bad format.\n");
+                return 1;
+            }
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--min-size") == 0)
+        {
+            if (!bench_parse_size(argv[++i], &min_size)) return 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--max-size") == 0)
+        {
+            if (!bench_parse_size(argv[++i], &max_size)) return 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--size") == 0)
+        {
+            if (!bench_parse_size(argv[++i], &min_size)) return 1;
+            max_size = min_size;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--distribution") == 0)
+        {
+            i += 1;
+            for (d = 0; d < CDSA_BENCH_DISTRIBUTIONS; d++)
+            {
+                if (strcmp(argv[i], bench_distribution_names[d]) == 0) break;
+            }
+            if (d == CDSA_BENCH_DISTRIBUTIONS)
+            {
+                fprintf(stderr, "Invalid arguments: bad distribution.\n");
+                return 1;
+            }
+            only_distribution = d;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--function") == 0)
+        {
+            only_function = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0)
+        {
+            seed = strtoul(argv[++i], NULL, 10) & 0xFFFFFFFFul;
+            if (seed == 0) seed = 1; /* xorshift never leaves 0 */
+        }
+        else
+        {
+            fprintf(stderr, "Invalid arguments: unknown \"%s\".\n", argv[i]);
+            return 1;
+        }
+    }
+    if (min_size > max_size)
+    {
+        fprintf(stderr, "Invalid arguments: min size exceeds max size.\n");
+        return 1;
+    }
+    if (header && format == CDSA_BENCH_FORMAT_CSV)
+    {
+        printf(
+            "module,function,distribution,size,repeats,ns_per_element,"
+            "allocations,allocated_bytes,peak_heap_bytes,peak_rss_kb,status\n"
+        );
+    }
+    /* Sizes are min_size times powers of 10, then max_size if not hit */
+    for (n = min_size; n > 0; )
+    {
+        input = malloc(n * sizeof(int));
+        work = malloc(n * sizeof(int));
+        if (input == NULL || work == NULL)
+        {
+            fprintf(stderr, "Failed to allocate %d-element input.\n", n);
+            free(input);
+            free(work);
+            return 1;
+        }
+        for (d = 0; d < CDSA_BENCH_DISTRIBUTIONS; d++)
+        {
+            if (only_distribution >= 0 && d != only_distribution) continue;
+            bench_random_state = seed;
+            bench_generate(input, n, d);
+            for (f = 0; f < function_count; f++)
+            {
+                const BenchFunction *function = &bench_functions[f];
+                for (p = 0; p < function->phase_count; p++)
+                {
+                    if (only_function == NULL
+                        || strcmp(only_function, function->phases[p]) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (p == function->phase_count) continue;
+                if ((function->degenerate & CDSA_BENCH_MASK(d))
+                    && n > CDSA_BENCH_DEGENERATE_MAX_SIZE)
+                {
+                    for (p = 0; p < function->phase_count; p++)
+                    {
+                        bench_print_row(
+                            format,
+                            function->phases[p],
+                            d,
+                            n,
+                            0,
+                            NULL,
+                            "skipped"
+                        );
+                    }
+                    continue;
+                }
+                bench_run(function, input, work, n, d, format);
+            }
+        }
+        free(input);
+        free(work);
+        if (n == max_size) break;
+        n = (n > max_size / 10) ? max_size : n * 10;
+    }
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file avl_tree.h
+ * @author HN Thap
+ * @brief AVL tree with iterative insertion, search and deletion (see
+ * src/avl_tree.c).
+ * 
+ * Define CDSA_AVL_TREE_ORDER_STATISTICS the same way for the library and
+ * the code including this header, since it changes the layout of AVLNode.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_AVL_TREE_H
+#define CDSA_AVL_TREE_H
+
+/**
+ * @brief Return code for success.
+ */
+#define CDSA_AVL_TREE_OK (0)
+
+/**
+ * @brief Return code for NULL reference.
+ */
+#define CDSA_AVL_TREE_NULL (2)
+
+/**
+ * @brief Return code for search miss.
+ */
+#define CDSA_AVL_TREE_NOT_FOUND (5)
+
+/**
+ * @brief Upper bound of the height of any AVL tree with up to INT_MAX nodes
+ * (about 1.44 * log2(n)), used to size the insertion and deletion paths.
+ */
+#define CDSA_AVL_TREE_MAX_HEIGHT (64)
+
+/**
+ * @brief Number of pending nodes an AVL tree iterator can hold, which is at
+ * least the height of any AVL tree.
+ */
+#define CDSA_AVL_TREE_ITERATOR_DEPTH (CDSA_AVL_TREE_MAX_HEIGHT)
+
+#if defined(CDSA_AVL_TREE_STATS)
+/**
+ * @brief Counters of the instrumented build.
+ */
+typedef struct AVLTreeStats
+{
+    unsigned long left_rotations; /* Calls to left_rotate_avl() */
+    unsigned long right_rotations; /* Calls to right_rotate_avl() */
+} AVLTreeStats;
+
+extern AVLTreeStats avl_tree_stats;
+#endif
+
+/**
+ * @brief Basic structure of an AVL tree node.
+ * 
+ * Only the balance factor (left height minus right height) is stored. In a
+ * valid AVL tree it is always -1, 0 or 1, so two bits are enough. This saves
+ * no memory though: the bitfield still takes a whole int next to data, which
+ * the pointers are aligned after, so the node is as large as with an int
+ * height (24 bytes on LP64, 16 bytes on ILP32).
+ * 
+ * With CDSA_AVL_TREE_ORDER_STATISTICS defined, each node also keeps the size
+ * of its subtree, kept up to date by insertion, deletion and the rotations,
+ * so select_kth_avl() and rank_of_avl() run in O(log n).
+ */
+typedef struct AVLNode
+{
+    int data;
+    signed int balance : 2;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    int size; /* Number of nodes in the subtree rooted here */
+#endif
+    struct AVLNode *left;
+    struct AVLNode *right;
+} AVLNode;
+
+/**
+ * @brief Read-only snapshot of an AVL tree in Eytzinger (BFS) order: the
+ * children of keys[k] are keys[2k] and keys[2k + 1], so no pointers or
+ * balance factors are stored.
+ */
+typedef struct FrozenAVL
+{
+    int *keys; /* keys[1..count], keys[0] is unused */
+    int count;
+} FrozenAVL;
+
+/**
+ * @brief Allocation-free in-order iterator over the keys in [lo, hi] of a
+ * BST. It is invalidated by any change to the tree.
+ */
+typedef struct AVLIterator
+{
+    const AVLNode *stack[CDSA_AVL_TREE_ITERATOR_DEPTH];
+    int top;
+    int lo;
+    int hi;
+} AVLIterator;
+
+/**
+ * @brief Allocate and initialize new AVL tree node.
+ * 
+ * @param data Data
+ * @param balance AVL node balance factor (-1, 0 or 1)
+ * @param left Left child
+ * @param right Right child
+ * @return AVLNode* Pointer to new allocated block if success,
+ * otherwise, NULL.
+ */
+AVLNode *new_avl_node(int data, int balance, AVLNode *left, AVLNode *right);
+
+/**
+ * @brief Retrieve node height by following the taller child down to a leaf.
+ * 
+ * @param node Pointer to node
+ * @return int 0 if node pointer is NULL, otherwise, node's height.
+ */
+int get_avl_height(AVLNode *node);
+
+/**
+ * @brief Retrieve the difference between left and right subtree heights.
+ * This is the balance factor for AVL logic.
+ * 
+ * @param node Pointer to node
+ * @return int Balance factor
+ */
+int get_avl_balance(AVLNode *node);
+
+/**
+ * @brief Standard right rotation in AVL tree. Balance factors are left to
+ * the caller, which knows them from the rebalancing case.
+ * 
+ * @param y Root node pointer before rotating
+ * @return AVLNode* Root node pointer after rotating
+ */
+AVLNode *right_rotate_avl(AVLNode *y);
+
+/**
+ * @brief Standard left rotation in AVL tree. Balance factors are left to
+ * the caller, which knows them from the rebalancing case.
+ * 
+ * @param x Root node pointer before rotating.
+ * @return AVLNode* Root node pointer after rotating.
+ */
+AVLNode *left_rotate_avl(AVLNode *x);
+
+/**
+ * @brief Insert node into AVL tree without recursion.
+ * 
+ * @param node Pointer to tree's root node
+ * @param data Inserted data
+ * @return AVLNode* Pointer to new tree's root node,
+ * otherwise, NULL when allocation fails (the tree is left unchanged).
+ */
+AVLNode *insert_avl(AVLNode *node, int data);
+
+/**
+ * @brief Link an already allocated node into an AVL tree without recursion,
+ * then rebalance along the insertion path. Rebalancing stops as soon as a
+ * subtree keeps its old height, since nothing above it can change.
+ * 
+ * @param root_ref Reference of the pointer to tree's root node
+ * @param node Pointer to the node to insert (its children are reset)
+ */
+void insert_avl_node(AVLNode **root_ref, AVLNode *node);
+
+/**
+ * @brief Build a perfectly balanced AVL tree from a sorted array in O(n),
+ * without any rotation. The middle element of each range becomes the
+ * subtree root.
+ * 
+ * @param arr Pointer to array sorted in non-decreasing order
+ * @param n Array size
+ * @return AVLNode* Pointer to new tree's root node,
+ * otherwise, NULL when n is 0, the input is invalid or allocation fails.
+ */
+AVLNode *build_avl_from_sorted(const int *arr, int n);
+
+/**
+ * @brief Search for a node holding the given data.
+ * 
+ * @param node Pointer to tree's root node
+ * @param data Searched data
+ * @return AVLNode* Pointer to a matching node if found,
+ * otherwise, NULL.
+ */
+AVLNode *search_avl(AVLNode *node, int data);
+
+/**
+ * @brief Delete one node holding the given data, then rebalance along the
+ * deletion path. Rebalancing stops as soon as a subtree keeps its old height.
+ * 
+ * @param root_ref Reference of the pointer to tree's root node
+ * @param data Deleted data
+ * @return int CDSA_AVL_TREE_OK if success,
+ * CDSA_AVL_TREE_NULL if root_ref is NULL,
+ * CDSA_AVL_TREE_NOT_FOUND if no node holds the data.
+ */
+int delete_avl(AVLNode **root_ref, int data);
+
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+/**
+ * @brief Retrieve the k-th smallest key of an AVL tree (only with
+ * CDSA_AVL_TREE_ORDER_STATISTICS).
+ * 
+ * @param root Pointer to tree's root node
+ * @param k Zero-based position of the key in sorted order
+ * @param data_ref Reference to the retrieved key
+ * @return int CDSA_AVL_TREE_OK if success,
+ * CDSA_AVL_TREE_NULL if data_ref is NULL,
+ * CDSA_AVL_TREE_NOT_FOUND if k is out of range.
+ */
+int select_kth_avl(AVLNode *root, int k, int *data_ref);
+
+/**
+ * @brief Retrieve the rank of a value in an AVL tree, i.e. the number of keys
+ * less than it (only with CDSA_AVL_TREE_ORDER_STATISTICS).
+ * 
+ * @param root Pointer to tree's root node
+ * @param data Value to rank (it does not have to be stored)
+ * @param rank_ref Reference to the rank
+ * @return int CDSA_AVL_TREE_OK if success,
+ * CDSA_AVL_TREE_NULL if rank_ref is NULL.
+ */
+int rank_of_avl(AVLNode *root, int data, int *rank_ref);
+#endif
+
+/**
+ * @brief Freeze an AVL tree into a pointer-free Eytzinger layout. The tree
+ * itself is left unchanged, and later changes to it are not reflected.
+ * 
+ * @param root Pointer to tree's root node
+ * @return FrozenAVL* Pointer to new allocated snapshot,
+ * otherwise, NULL when allocation fails.
+ */
+FrozenAVL *freeze_avl(AVLNode *root);
+
+/**
+ * @brief Search data inside a frozen AVL tree with a branchless descent that
+ * prefetches four levels ahead.
+ * 
+ * @param frozen Pointer to frozen AVL tree
+ * @param data Searched data
+ * @return int CDSA_AVL_TREE_OK if found,
+ * or CDSA_AVL_TREE_NOT_FOUND if not found,
+ * otherwise, CDSA_AVL_TREE_NULL when the frozen tree pointer is NULL.
+ */
+int search_frozen_avl(const FrozenAVL *frozen, int data);
+
+/**
+ * @brief Destroy a frozen AVL tree.
+ * 
+ * @param frozen Pointer to frozen AVL tree
+ */
+void destroy_frozen_avl(FrozenAVL *frozen);
+
+/**
+ * @brief Position an iterator at the first key in [lo, hi] of an AVL tree.
+ * Subtrees entirely outside the range are never visited, so a whole range
+ * query touches O(h + k) nodes for a tree of height h and k results.
+ * 
+ * @param root Pointer to tree's root node
+ * @param lo Smallest key to yield
+ * @param hi Largest key to yield
+ * @param iterator Pointer to iterator
+ * @return int CDSA_AVL_TREE_OK if success,
+ * otherwise, CDSA_AVL_TREE_NULL when the iterator pointer is NULL.
+ */
+int seek_avl_iterator(
+    AVLNode *root,
+    int lo,
+    int hi,
+    AVLIterator *iterator
+);
+
+/**
+ * @brief Yield the next keys of an iterator, in non-decreasing order, into a
+ * caller-provided buffer.
+ * 
+ * @param iterator Pointer to iterator
+ * @param out Pointer to buffer
+ * @param capacity Maximum number of keys to yield
+ * @param count_ref Reference to the number of keys yielded (0 once the
+ * iterator is exhausted)
+ * @return int CDSA_AVL_TREE_OK if success,
+ * otherwise, CDSA_AVL_TREE_NULL when a pointer is NULL.
+ */
+int next_avl_iterator(
+    AVLIterator *iterator,
+    int *out,
+    int capacity,
+    int *count_ref
+);
+
+/**
+ * @brief Copy the keys in [lo, hi] of an AVL tree into a buffer, in
+ * non-decreasing order. At most capacity keys are copied; an iterator from
+ * seek_avl_iterator() retrieves any number of them lazily instead.
+ * 
+ * @param root Pointer to tree's root node
+ * @param lo Smallest key to copy
+ * @param hi Largest key to copy
+ * @param out Pointer to buffer
+ * @param capacity Buffer size
+ * @param count_ref Reference to the number of keys copied
+ * @return int Same as seek_avl_iterator()
+ */
+int range_avl(
+    AVLNode *root,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+);
+
+/**
+ * @brief Destroy an AVL tree with all of his children, the children's children,
+ * and so on.
+ * 
+ * @param node Pointer to tree's root node
+ */
+void destroy_avl(AVLNode *node);
+
+/**
+ * @brief Print an AVL tree sideways to standard output.
+ * 
+ * @param node Pointer to node
+ * @param depth Node depth
+ * @param is_right_child Whether this node is a right child of another
+ * (zero means false, non-zero means true)
+ */
+void print_avl_sideways(const AVLNode *node, int depth);
+
+#endif /* CDSA_AVL_TREE_H */
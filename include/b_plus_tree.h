@@ -0,0 +1,249 @@
+/**
+ * @file b_plus_tree.h
+ * @author HN Thap
+ * @brief B+ tree with cache-line sized nodes and linked leaves (see
+ * src/b_plus_tree.c).
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_BPLUS_TREE_H
+#define CDSA_BPLUS_TREE_H
+
+/**
+ * @brief Return code for B+ tree that indicates success.
+ */
+#define CDSA_BPLUS_TREE_OK (0)
+/**
+ * @brief Return code for B+ tree that indicates failure.
+ */
+#define CDSA_BPLUS_TREE_FAILED (1)
+/**
+ * @brief Return code for B+ tree that indicates errors involving NULL.
+ */
+#define CDSA_BPLUS_TREE_NULL (2)
+/**
+ * @brief Return code for B+ tree that indicates errors involving empty
+ * structures (for example, an iterator that has reached the end).
+ */
+#define CDSA_BPLUS_TREE_EMPTY (3)
+/**
+ * @brief Return code for B+ tree that indicates allocation failure.
+ */
+#define CDSA_BPLUS_TREE_ALLOC_FAILED (4)
+/**
+ * @brief Return code for B+ tree that indicates a failed search operation,
+ * or a failed pop operation due to inexistent value.
+ */
+#define CDSA_BPLUS_TREE_NOT_FOUND (5)
+
+/**
+ * @brief Maximum number of keys in a node. 16 ints fill one 64-byte cache
+ * line, and match the width of the vectorized key search.
+ */
+#define CDSA_BPLUS_TREE_NODE_KEYS (16)
+
+/**
+ * @brief B+ tree leaf node. Leaves hold every key of the tree and are linked
+ * in order for range scans.
+ */
+typedef struct BPlusLeaf
+{
+    int keys[CDSA_BPLUS_TREE_NODE_KEYS];
+    int count;
+    struct BPlusLeaf *next;
+} BPlusLeaf;
+
+/**
+ * @brief B+ tree inner node. Keys in children[i] are not greater than
+ * keys[i], and keys in children[i + 1] are not less than keys[i]. Children
+ * are inner nodes, except on the level right above the leaves.
+ */
+typedef struct BPlusInner
+{
+    int keys[CDSA_BPLUS_TREE_NODE_KEYS];
+    int count;
+    void *children[CDSA_BPLUS_TREE_NODE_KEYS + 1];
+} BPlusInner;
+
+/**
+ * @brief Basic structure for a B+ tree.
+ * 
+ * When leaves is not NULL (see new_bplus_tree_with_arena()), nodes are taken
+ * from the leaves and inners arenas instead of being allocated one by one,
+ * and are only recycled all at once by clear_bplus_tree().
+ */
+typedef struct BPlusTree
+{
+    void *root; /* BPlusLeaf when height is 1, otherwise BPlusInner */
+    int height; /* 0 when the tree is empty */
+    int count;
+    BPlusLeaf *leaves;
+    int leaf_count;
+    int leaf_capacity;
+    BPlusInner *inners;
+    int inner_count;
+    int inner_capacity;
+} BPlusTree;
+
+/**
+ * @brief Forward iterator over the keys of a B+ tree, in non-decreasing
+ * order. It does not allocate, and is invalidated by push and pop.
+ */
+typedef struct BPlusTreeIterator
+{
+    const BPlusLeaf *leaf;
+    int index;
+} BPlusTreeIterator;
+
+/**
+ * @brief Allocate and initialize an empty B+ tree.
+ * 
+ * @return BPlusTree* Pointer to new allocated block,
+ * otherwise, NULL when allocation fails
+ */
+BPlusTree *new_bplus_tree();
+
+/**
+ * @brief Allocate and initialize an empty B+ tree whose nodes come from two
+ * arenas sized for the given number of pushes, which saves one allocation
+ * per split (Tree sort builds its B+ trees this way).
+ * 
+ * Nodes emptied by pop_bplus_tree() are not reused before the tree is
+ * cleared, so pushing more than capacity keys, or pushing again after pops,
+ * may fail with CDSA_BPLUS_TREE_ALLOC_FAILED.
+ * 
+ * @param capacity Number of keys the arenas can hold
+ * @return BPlusTree* Pointer to new allocated block,
+ * otherwise, NULL when capacity is negative or allocation fails
+ */
+BPlusTree *new_bplus_tree_with_arena(int capacity);
+
+/**
+ * @brief Push new key to a B+ tree. Duplicate keys are kept.
+ * 
+ * @param tree Pointer to B+ tree
+ * @param data Data to be stored
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * or, CDSA_BPLUS_TREE_NULL if tree pointer is NULL,
+ * otherwise, CDSA_BPLUS_TREE_ALLOC_FAILED when failed to allocate nodes, or
+ * when the arenas are full (the tree is left unchanged).
+ */
+int push_bplus_tree(BPlusTree *tree, int data);
+
+/**
+ * @brief Pop (delete) one key from a B+ tree.
+ * 
+ * @param tree Pointer to B+ tree
+ * @param data Data to delete
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * or, CDSA_BPLUS_TREE_NOT_FOUND if the data is not found,
+ * otherwise, CDSA_BPLUS_TREE_NULL if tree pointer is NULL.
+ */
+int pop_bplus_tree(BPlusTree *tree, int data);
+
+/**
+ * @brief Search data inside a B+ tree.
+ * 
+ * @param tree Pointer to B+ tree
+ * @param data Data to search
+ * @return int CDSA_BPLUS_TREE_OK if found,
+ * or CDSA_BPLUS_TREE_NOT_FOUND if not found,
+ * otherwise, CDSA_BPLUS_TREE_NULL when the tree pointer is NULL.
+ */
+int search_bplus_tree(const BPlusTree *tree, int data);
+
+/**
+ * @brief Position an iterator at the smallest key of a B+ tree.
+ * 
+ * @param tree Pointer to B+ tree
+ * @param iterator Pointer to iterator
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * otherwise, CDSA_BPLUS_TREE_NULL when a pointer is NULL.
+ */
+int begin_bplus_tree_iterator(
+    const BPlusTree *tree,
+    BPlusTreeIterator *iterator
+);
+
+/**
+ * @brief Position an iterator at the first key not less than the given data,
+ * which is where a range scan starts.
+ * 
+ * @param tree Pointer to B+ tree
+ * @param data Lower bound of the range
+ * @param iterator Pointer to iterator
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * otherwise, CDSA_BPLUS_TREE_NULL when a pointer is NULL.
+ */
+int seek_bplus_tree_iterator(
+    const BPlusTree *tree,
+    int data,
+    BPlusTreeIterator *iterator
+);
+
+/**
+ * @brief Retrieve the key at an iterator, then advance it.
+ * 
+ * @param iterator Pointer to iterator
+ * @param data_ref Reference to the retrieved key
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * or, CDSA_BPLUS_TREE_EMPTY when there are no more keys,
+ * otherwise, CDSA_BPLUS_TREE_NULL when a pointer is NULL.
+ */
+int next_bplus_tree_iterator(BPlusTreeIterator *iterator, int *data_ref);
+
+/**
+ * @brief Recursively clear a B+ tree node and all of its children
+ * (particularly used inside clear_bplus_tree()).
+ * 
+ * @param node Pointer to node
+ * @param level Node level (0 for the root)
+ * @param height Tree height
+ */
+void clear_bplus_tree_recursive(void *node, int level, int height);
+
+/**
+ * @brief Clear a B+ tree (without destroying it).
+ * 
+ * @param tree Pointer to B+ tree
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * otherwise, CDSA_BPLUS_TREE_NULL when the tree pointer is NULL.
+ */
+int clear_bplus_tree(BPlusTree *tree);
+
+/**
+ * @brief Destroy a B+ tree.
+ * 
+ * @param tree_ref Reference of the pointer to B+ tree
+ * @return int CDSA_BPLUS_TREE_OK if success,
+ * otherwise, CDSA_BPLUS_TREE_NULL when the B+ tree reference is NULL.
+ */
+int destroy_bplus_tree(BPlusTree **tree_ref);
+
+/**
+ * @brief Print a B+ tree node and its children recursively sideways to
+ * standard output (particularly used inside print_bplus_tree_sideways()).
+ * 
+ * @param node Pointer to node
+ * @param level Node level (0 for the root)
+ * @param height Tree height
+ */
+void print_bplus_tree_sideways_recursive(
+    const void *node,
+    int level,
+    int height
+);
+
+/**
+ * @brief Print a B+ tree sideways to standard output, one leaf per line.
+ * 
+ * @param tree Pointer to tree
+ * @return CDSA_BPLUS_TREE_OK if success,
+ * otherwise, CDSA_BPLUS_TREE_NULL if tree pointer is NULL
+ */
+int print_bplus_tree_sideways(const BPlusTree *tree);
+
+#endif /* CDSA_BPLUS_TREE_H */
@@ -0,0 +1,165 @@
+/**
+ * @file concurrent_bst.h
+ * @author HN Thap
+ * @brief Thread-safe, unbalanced binary search tree of distinct keys, whose
+ * readers never lock (see src/concurrent_bst.c).
+ * 
+ * Every thread that searches the tree attaches its own reader first:
+ * 
+ *     ConcurrentBSTReader *reader = attach_concurrent_bst_reader(set);
+ *     if (search_concurrent_bst(reader, 42) == CDSA_CONCURRENT_BST_OK) ...
+ *     (void)detach_concurrent_bst_reader(&reader);
+ * 
+ * push_concurrent_bst() and pop_concurrent_bst() need no reader and can be
+ * called from any thread at any time.
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_CONCURRENT_BST_H
+#define CDSA_CONCURRENT_BST_H
+
+/**
+ * @brief Return code for concurrent BST that indicates success.
+ */
+#define CDSA_CONCURRENT_BST_OK (0)
+/**
+ * @brief Return code for concurrent BST that indicates failure.
+ */
+#define CDSA_CONCURRENT_BST_FAILED (1)
+/**
+ * @brief Return code for concurrent BST that indicates errors involving
+ * NULL.
+ */
+#define CDSA_CONCURRENT_BST_NULL (2)
+/**
+ * @brief Return code for concurrent BST that indicates allocation failure.
+ */
+#define CDSA_CONCURRENT_BST_ALLOC_FAILED (4)
+/**
+ * @brief Return code for concurrent BST that indicates a failed search
+ * operation, i.e. item is not found.
+ */
+#define CDSA_CONCURRENT_BST_NOT_FOUND (5)
+/**
+ * @brief Return code for concurrent BST that indicates the pushed item is
+ * already in the tree (it is left unchanged).
+ */
+#define CDSA_CONCURRENT_BST_DUPLICATE (6)
+
+/**
+ * @brief A concurrent BST. Its fields are only accessed through the
+ * functions below.
+ */
+typedef struct ConcurrentBST ConcurrentBST;
+
+/**
+ * @brief Read access of one thread to a concurrent BST. A reader must not be
+ * used by several threads at the same time.
+ */
+typedef struct ConcurrentBSTReader ConcurrentBSTReader;
+
+/**
+ * @brief Allocate and initialize an empty concurrent BST.
+ * 
+ * @return ConcurrentBST* Pointer to new allocated block,
+ * otherwise, NULL when allocation fails
+ */
+ConcurrentBST *new_concurrent_bst();
+
+/**
+ * @brief Attach a new reader to a concurrent BST. Detached readers are
+ * recycled, so attaching and detaching repeatedly does not leak.
+ * 
+ * @param set The tree
+ * @return ConcurrentBSTReader* The reader,
+ * otherwise, NULL when the tree pointer is NULL or allocation fails
+ */
+ConcurrentBSTReader *attach_concurrent_bst_reader(ConcurrentBST *set);
+
+/**
+ * @brief Detach a reader from its tree and set the reference to NULL.
+ * 
+ * @param reader_ref Reference of the reader
+ * @return int CDSA_CONCURRENT_BST_OK if success,
+ * otherwise, CDSA_CONCURRENT_BST_NULL when the reference is NULL.
+ */
+int detach_concurrent_bst_reader(ConcurrentBSTReader **reader_ref);
+
+/**
+ * @brief Push a key to a concurrent BST. Writers are serialized, but never
+ * wait for readers, except to reclaim a full batch of popped nodes.
+ * 
+ * @param set The tree
+ * @param data The key
+ * @return int CDSA_CONCURRENT_BST_OK if success,
+ * or, CDSA_CONCURRENT_BST_DUPLICATE if the key is already in the tree,
+ * or, CDSA_CONCURRENT_BST_NULL if tree pointer is NULL,
+ * otherwise, CDSA_CONCURRENT_BST_ALLOC_FAILED when failed to allocate node.
+ */
+int push_concurrent_bst(ConcurrentBST *set, int data);
+
+/**
+ * @brief Pop (delete) a key from a concurrent BST. Popping a node with two
+ * children copies the path to its successor, which allocates.
+ * 
+ * @param set The tree
+ * @param data The key
+ * @return int CDSA_CONCURRENT_BST_OK if success,
+ * or, CDSA_CONCURRENT_BST_NOT_FOUND if the key is not found,
+ * or, CDSA_CONCURRENT_BST_NULL if tree pointer is NULL,
+ * otherwise, CDSA_CONCURRENT_BST_ALLOC_FAILED when failed to allocate the
+ * copies (the tree is left unchanged).
+ */
+int pop_concurrent_bst(ConcurrentBST *set, int data);
+
+/**
+ * @brief Search a key inside a concurrent BST, without locking.
+ * 
+ * @param reader The reader of the calling thread
+ * @param data The key
+ * @return int CDSA_CONCURRENT_BST_OK if found,
+ * or CDSA_CONCURRENT_BST_NOT_FOUND if not found,
+ * otherwise, CDSA_CONCURRENT_BST_NULL when the reader pointer is NULL.
+ */
+int search_concurrent_bst(ConcurrentBSTReader *reader, int data);
+
+/**
+ * @brief Copy the keys in [lo, hi] of a concurrent BST into a buffer, in
+ * increasing order, without locking. Every key copied was in the tree at
+ * some point of the call; keys pushed or popped meanwhile may be missed.
+ * Each key costs one descent, and popped nodes are not reclaimed until the
+ * call returns, so prefer a moderate capacity.
+ * 
+ * @param reader The reader of the calling thread
+ * @param lo Lower bound of the range
+ * @param hi Upper bound of the range
+ * @param out The buffer
+ * @param capacity Size of the buffer
+ * @param count_ref Where to store the number of keys copied
+ * @return int CDSA_CONCURRENT_BST_OK if success,
+ * otherwise, CDSA_CONCURRENT_BST_NULL when a pointer is NULL.
+ */
+int range_concurrent_bst(
+    ConcurrentBSTReader *reader,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+);
+
+/**
+ * @brief Destroy a concurrent BST and all of its readers, and set the
+ * reference to NULL. No other thread may use the tree or its readers
+ * anymore.
+ * 
+ * @param set_ref Reference of the tree
+ * @return int CDSA_CONCURRENT_BST_OK if success,
+ * otherwise, CDSA_CONCURRENT_BST_NULL when the reference is NULL.
+ */
+int destroy_concurrent_bst(ConcurrentBST **set_ref);
+
+#endif /* CDSA_CONCURRENT_BST_H */
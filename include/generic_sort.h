@@ -0,0 +1,342 @@
+/**
+ * @file generic_sort.h
+ * @author HN Thap
+ * @brief Type-specialized merge sort and tree sort, generated by macros.
+ * 
+ * merge_sort.c and tree_sort.c sort int only. For any other element type,
+ * expand the matching macro once at file scope, for example:
+ * 
+ *     #define LESS_INT64(a, b) ((a) < (b))
+ *     CDSA_DEFINE_MERGE_SORT(int64_t, LESS_INT64)
+ * 
+ * which defines merge_sort_int64_t(count, arr). The type must be a single
+ * identifier (use a typedef for structs or multi-word types), and less(a, b)
+ * is an expression on two values of that type, non-zero when a has to come
+ * before b. Since less is expanded in place, a function-like macro costs no
+ * call at all, unlike the comparator of merge_sort_generic() or qsort().
+ * 
+ * Both sorts are stable, so records with equal keys keep their order.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_GENERIC_SORT_H
+#define CDSA_GENERIC_SORT_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @brief Return code for success.
+ */
+#define CDSA_GENERIC_SORT_OK (0)
+
+/**
+ * @brief Return code when a NULL pointer is passed.
+ */
+#define CDSA_GENERIC_SORT_NULL (2)
+
+/**
+ * @brief Return code for memory allocation failure.
+ */
+#define CDSA_GENERIC_SORT_ALLOC_FAILED (4)
+
+/**
+ * @brief Subarrays of this many elements or fewer are insertion-sorted.
+ */
+#define CDSA_GENERIC_SORT_INSERTION_THRESHOLD (32)
+
+/**
+ * @brief Upper bound of the height of the AVL tree of a generated tree sort,
+ * for any count that fits in size_t (about 1.44 * log2(count)).
+ */
+#define CDSA_GENERIC_SORT_MAX_HEIGHT (96)
+
+/**
+ * @brief Define merge_sort_<type>(), see CDSA_DEFINE_MERGE_SORT_NAMED().
+ */
+#define CDSA_DEFINE_MERGE_SORT(type, less) \
+    CDSA_DEFINE_MERGE_SORT_NAMED(merge_sort_##type, type, less)
+
+/**
+ * @brief Define a stable, buffer-based merge sort of an array of type:
+ * 
+ *     static int name(size_t count, type *arr);
+ * 
+ * It works like merge_sort() and returns CDSA_GENERIC_SORT_OK if success,
+ * or CDSA_GENERIC_SORT_NULL if arr is NULL, otherwise,
+ * CDSA_GENERIC_SORT_ALLOC_FAILED if failed to allocate the buffer.
+ */
+#define CDSA_DEFINE_MERGE_SORT_NAMED(name, type, less) \
+static void name##_insertion(type *arr, size_t left, size_t right) \
+{ \
+    size_t i, j; \
+    type key; \
+    for (i = left + 1; i < right; i++) \
+    { \
+        key = arr[i]; \
+        for (j = i; j > left && less(key, arr[j - 1]); j--) \
+        { \
+            arr[j] = arr[j - 1]; \
+        } \
+        arr[j] = key; \
+    } \
+} \
+ \
+static void name##_merge( \
+    type *arr, \
+    size_t left, \
+    size_t middle, \
+    size_t right, \
+    type *buffer \
+) \
+{ \
+    size_t i = left, j = middle, k = left; \
+    size_t take_right; \
+    while (i < middle && j < right) \
+    { \
+        /* Right half only when strictly less (stable), and no data- \
+         * dependent branch: this compiles to conditional moves. */ \
+        take_right = less(arr[j], arr[i]) != 0; \
+        buffer[k++] = *(take_right ? &arr[j] : &arr[i]); \
+        i += !take_right; \
+        j += take_right; \
+    } \
+    while (i < middle) buffer[k++] = arr[i++]; \
+    for (i = left; i < j; i++) \
+    { \
+        arr[i] = buffer[i]; \
+    } \
+} \
+ \
+static void name##_recursive( \
+    type *arr, \
+    size_t left, \
+    size_t right, \
+    type *buffer \
+) \
+{ \
+    size_t middle; \
+    if (right - left <= CDSA_GENERIC_SORT_INSERTION_THRESHOLD) \
+    { \
+        name##_insertion(arr, left, right); \
+        return; \
+    } \
+    middle = left + (right - left) / 2; \
+    name##_recursive(arr, left, middle, buffer); \
+    name##_recursive(arr, middle, right, buffer); \
+    if (!less(arr[middle], arr[middle - 1])) \
+    { \
+        /* Both halves are already in order. */ \
+        return; \
+    } \
+    name##_merge(arr, left, middle, right, buffer); \
+} \
+ \
+static int name(size_t count, type *arr) \
+{ \
+    type *buffer; \
+    if (arr == NULL) return CDSA_GENERIC_SORT_NULL; \
+    if (count < 2) return CDSA_GENERIC_SORT_OK; \
+    buffer = malloc(count * sizeof(type)); \
+    if (buffer == NULL) return CDSA_GENERIC_SORT_ALLOC_FAILED; \
+    name##_recursive(arr, 0, count, buffer); \
+    free(buffer); \
+    return CDSA_GENERIC_SORT_OK; \
+}
+
+/**
+ * @brief Define tree_sort_<type>(), see CDSA_DEFINE_TREE_SORT_NAMED().
+ */
+#define CDSA_DEFINE_TREE_SORT(type, less) \
+    CDSA_DEFINE_TREE_SORT_NAMED(tree_sort_##type, type, less)
+
+/**
+ * @brief Define a stable tree sort of an array of type, on an AVL tree whose
+ * nodes come from one arena:
+ * 
+ *     static int name(size_t count, type *arr);
+ * 
+ * It returns the same codes as the merge sort above. As in tree_sort.c,
+ * equal keys share one tree node: the later ones are chained behind it in
+ * input order, so runs of equal keys never deepen the tree. The descent
+ * makes a single less() call per level, and detects an equal key with one
+ * more call at the bottom. Insertions rebalance the tree as insert_avl_node()
+ * does, so sorted and reverse-sorted input stay O(n log n), and the tree is
+ * read back by Morris traversal, without recursion nor stack.
+ */
+#define CDSA_DEFINE_TREE_SORT_NAMED(name, type, less) \
+typedef struct name##_node \
+{ \
+    type data; \
+    signed char balance; /* Left height minus right height */ \
+    struct name##_node *left; \
+    struct name##_node *right; \
+    struct name##_node *next; /* Next equal key, in input order */ \
+    struct name##_node *last; /* Last equal key (only in the tree node) */ \
+} name##_node; \
+ \
+static name##_node *name##_rotate_right(name##_node *x) \
+{ \
+    name##_node *y = x->left; \
+    x->left = y->right; \
+    y->right = x; \
+    return y; \
+} \
+ \
+static name##_node *name##_rotate_left(name##_node *x) \
+{ \
+    name##_node *y = x->right; \
+    x->right = y->left; \
+    y->left = x; \
+    return y; \
+} \
+ \
+/* Rebalance *link, two levels higher on the left after an insertion. */ \
+static void name##_fix_left(name##_node **link) \
+{ \
+    name##_node *current = *link; \
+    name##_node *left = current->left; \
+    name##_node *pivot; \
+    if (left->balance > 0) \
+    { \
+        *link = name##_rotate_right(current); \
+        current->balance = 0; \
+        left->balance = 0; \
+        return; \
+    } \
+    pivot = left->right; \
+    current->left = name##_rotate_left(left); \
+    *link = name##_rotate_right(current); \
+    current->balance = (pivot->balance > 0) ? -1 : 0; \
+    left->balance = (pivot->balance < 0) ? 1 : 0; \
+    pivot->balance = 0; \
+} \
+ \
+static void name##_fix_right(name##_node **link) \
+{ \
+    name##_node *current = *link; \
+    name##_node *right = current->right; \
+    name##_node *pivot; \
+    if (right->balance < 0) \
+    { \
+        *link = name##_rotate_left(current); \
+        current->balance = 0; \
+        right->balance = 0; \
+        return; \
+    } \
+    pivot = right->left; \
+    current->right = name##_rotate_right(right); \
+    *link = name##_rotate_left(current); \
+    current->balance = (pivot->balance < 0) ? 1 : 0; \
+    right->balance = (pivot->balance > 0) ? -1 : 0; \
+    pivot->balance = 0; \
+} \
+ \
+static void name##_push(name##_node **root_ref, name##_node *node) \
+{ \
+    name##_node **path[CDSA_GENERIC_SORT_MAX_HEIGHT]; \
+    unsigned char went_right[CDSA_GENERIC_SORT_MAX_HEIGHT]; \
+    name##_node **link = root_ref; \
+    name##_node *candidate = NULL; \
+    name##_node *current; \
+    int depth = 0; \
+    node->balance = 0; \
+    node->left = NULL; \
+    node->right = NULL; \
+    node->next = NULL; \
+    node->last = node; \
+    while (*link) \
+    { \
+        path[depth] = link; \
+        if (less(node->data, (*link)->data)) \
+        { \
+            went_right[depth++] = 0; \
+            link = &(*link)->left; \
+        } \
+        else \
+        { \
+            /* Not less: the last such node is the only possible equal */ \
+            candidate = *link; \
+            went_right[depth++] = 1; \
+            link = &(*link)->right; \
+        } \
+    } \
+    if (candidate != NULL && !less(candidate->data, node->data)) \
+    { \
+        candidate->last->next = node; \
+        candidate->last = node; \
+        return; \
+    } \
+    *link = node; \
+    /* Each ancestor's subtree grew on one side; stop once its height holds */ \
+    while (depth > 0) \
+    { \
+        link = path[--depth]; \
+        current = *link; \
+        if (!went_right[depth]) \
+        { \
+            if (current->balance++ == 0) continue; \
+            if (current->balance > 1) name##_fix_left(link); \
+            break; \
+        } \
+        if (current->balance-- == 0) continue; \
+        if (current->balance < -1) name##_fix_right(link); \
+        break; \
+    } \
+} \
+ \
+/* Morris traversal: the right link of each in-order predecessor points back \
+ * at its successor while the left subtree is written, then is restored. */ \
+static void name##_in_order(type *arr, name##_node *node) \
+{ \
+    name##_node *predecessor; \
+    name##_node *equal; \
+    size_t index = 0; \
+    while (node != NULL) \
+    { \
+        if (node->left != NULL) \
+        { \
+            predecessor = node->left; \
+            while (predecessor->right != NULL && predecessor->right != node) \
+            { \
+                predecessor = predecessor->right; \
+            } \
+            if (predecessor->right == NULL) \
+            { \
+                predecessor->right = node; \
+                node = node->left; \
+                continue; \
+            } \
+            predecessor->right = NULL; \
+        } \
+        for (equal = node; equal != NULL; equal = equal->next) \
+        { \
+            arr[index++] = equal->data; \
+        } \
+        node = node->right; \
+    } \
+} \
+ \
+static int name(size_t count, type *arr) \
+{ \
+    name##_node *arena; \
+    name##_node *root = NULL; \
+    size_t i; \
+    if (arr == NULL) return CDSA_GENERIC_SORT_NULL; \
+    if (count < 2) return CDSA_GENERIC_SORT_OK; \
+    arena = malloc(count * sizeof(name##_node)); \
+    if (arena == NULL) return CDSA_GENERIC_SORT_ALLOC_FAILED; \
+    for (i = 0; i < count; i++) \
+    { \
+        arena[i].data = arr[i]; \
+        name##_push(&root, &arena[i]); \
+    } \
+    name##_in_order(arr, root); \
+    free(arena); \
+    return CDSA_GENERIC_SORT_OK; \
+}
+
+#endif /* CDSA_GENERIC_SORT_H */
@@ -0,0 +1,390 @@
+/**
+ * @file merge_sort.h
+ * @author HN Thap
+ * @brief Merge sorts for int arrays and files (see src/merge_sort.c).
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_MERGE_SORT_H
+#define CDSA_MERGE_SORT_H
+
+#include <stddef.h>
+
+/**
+ * @brief Capacity of the run stack used by merge_sort_natural(). Run powers
+ * strictly increase from the bottom of the stack and cannot exceed the bit
+ * width of int, so this bound is never reached.
+ */
+#define CDSA_MERGE_SORT_MAX_RUNS (64)
+
+/**
+ * @brief Return code for merge sort that indicates success.
+ */
+#define CDSA_MERGE_SORT_OK (0)
+
+/**
+ * @brief Return code for merge sort that indicates failure.
+ */
+#define CDSA_MERGE_SORT_FAILED (1)
+
+/**
+ * @brief Return code for merge sort that indicates errors involving NULL.
+ */
+#define CDSA_MERGE_SORT_NULL (2)
+
+/**
+ * @brief Return code for merge sort that indicates the sorted stream has no
+ * element left.
+ */
+#define CDSA_MERGE_SORT_EMPTY (3)
+
+/**
+ * @brief Return code for merge sort that indicates allocation failure.
+ */
+#define CDSA_MERGE_SORT_ALLOC_FAILED (4)
+
+/**
+ * @brief Merge sort mode: use an n-sized buffer (merge_sort()).
+ */
+#define CDSA_MERGE_SORT_MODE_BUFFERED (0)
+
+/**
+ * @brief Merge sort mode: use O(1) extra memory (merge_sort_in_place()).
+ */
+#define CDSA_MERGE_SORT_MODE_IN_PLACE (1)
+
+/**
+ * @brief Reusable scratch space for merge_sort_with_context().
+ */
+typedef struct MergeSortContext
+{
+    int *buffer;
+    int capacity;
+} MergeSortContext;
+
+/**
+ * @brief Incremental sorter of merge_sort_stream_feed().
+ * 
+ * Every batch is sorted as it arrives and kept as a run in data, next to
+ * the previous ones. Run i spans [run_start[i], run_end[i]), and each run is
+ * at least twice as long as the next one, so there are at most 32 of them.
+ * Once finished, cursor[i] is the next unread element of run i, and the
+ * loser tree (loser, winner) picks the run holding the smallest one.
+ */
+typedef struct MergeSortStream
+{
+    int *data;
+    int *buffer;
+    int count;
+    int capacity;
+    int run_start[CDSA_MERGE_SORT_MAX_RUNS];
+    int run_end[CDSA_MERGE_SORT_MAX_RUNS];
+    int run_count;
+    int finished;
+    int cursor[CDSA_MERGE_SORT_MAX_RUNS];
+    int loser[CDSA_MERGE_SORT_MAX_RUNS];
+    int winner;
+} MergeSortStream;
+
+#if defined(CDSA_MERGE_SORT_STATS)
+/**
+ * @brief Counters of the instrumented build.
+ */
+typedef struct MergeSortStats
+{
+    unsigned long comparisons; /* Key comparisons of the scalar kernel */
+    unsigned long moves; /* Elements written by merges and copy-backs */
+    unsigned long merges; /* Calls to merge_sort_merge() */
+} MergeSortStats;
+
+extern MergeSortStats merge_sort_stats;
+#endif
+
+/**
+ * @brief Sort an array with a top-down merge sort and an n-sized buffer.
+ * Exits if the buffer cannot be allocated.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ */
+void merge_sort(int arr_count, int *arr);
+
+/**
+ * @brief Sort arr[left, right) with buffer as scratch space.
+ */
+void merge_sort_recursive(int *arr, int left, int right, int *buffer);
+
+/**
+ * @brief Merge the sorted arr[left, middle) and arr[middle, right) through
+ * buffer.
+ */
+void merge_sort_merge(int *arr, int left, int middle, int right, int *buffer);
+
+/**
+ * @brief Sort an array with a bottom-up merge sort that swaps the array and
+ * the buffer after each pass.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ */
+void merge_sort_bottom_up(int arr_count, int *arr);
+
+/**
+ * @brief Merge the sorted src[left, middle) and src[middle, right) into
+ * dst[left, right).
+ */
+void merge_sort_merge_into(
+    const int *src,
+    int *dst,
+    int left,
+    int middle,
+    int right
+);
+
+/**
+ * @brief Merge the sorted a and b into out, with the fastest kernel this
+ * CPU has. out must not overlap a or b.
+ */
+void merge_sort_merge_ranges(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+);
+
+/**
+ * @brief Scalar kernel of merge_sort_merge_ranges(), without data-dependent
+ * branches.
+ */
+void merge_sort_merge_ranges_branchless(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+);
+
+/**
+ * @brief Insertion-sort arr[left, right).
+ */
+void merge_sort_insertion(int *arr, int left, int right);
+
+/**
+ * @brief Sort an array by merging its natural runs in powersort order.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ */
+void merge_sort_natural(int arr_count, int *arr);
+
+/**
+ * @brief Return the end of the run of arr starting at left, after reversing
+ * it if it is strictly descending.
+ */
+int merge_sort_find_run(int *arr, int left, int arr_count);
+
+/**
+ * @brief Merge the two runs on top of the run stack of merge_sort_natural().
+ */
+void merge_sort_natural_merge_top(
+    const int *run_start,
+    int *run_length,
+    int top,
+    int *arr,
+    int *buffer
+);
+
+/**
+ * @brief Powersort priority of the boundary between two adjacent runs.
+ */
+int merge_sort_run_power(int s1, int n1, int n2, int arr_count);
+
+/**
+ * @brief Sort an array with up to num_threads threads (the calling thread
+ * included) on a work-stealing pool.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ */
+void merge_sort_parallel(int arr_count, int *arr, int num_threads);
+
+/**
+ * @brief Sort an array with a caller-supplied buffer of arr_count ints.
+ * Never allocates.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param buffer The scratch buffer
+ */
+void merge_sort_with_buffer(int arr_count, int *arr, int *buffer);
+
+/**
+ * @brief Create a new, empty merge sort context.
+ * 
+ * @return The context, or NULL if failed to allocate
+ */
+MergeSortContext *new_merge_sort_context();
+
+/**
+ * @brief Sort an array with the buffer of context, growing it if needed.
+ * 
+ * @param context The context
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if context
+ * or arr is NULL, otherwise CDSA_MERGE_SORT_ALLOC_FAILED
+ */
+int merge_sort_with_context(MergeSortContext *context, int arr_count, int *arr);
+
+/**
+ * @brief Free a merge sort context and set the reference to NULL.
+ * 
+ * @param context_ref Reference of the context
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if the
+ * reference is NULL
+ */
+int destroy_merge_sort_context(MergeSortContext **context_ref);
+
+/**
+ * @brief Sort an array with O(1) extra memory and O(log n) stack.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ */
+void merge_sort_in_place(int arr_count, int *arr);
+
+/**
+ * @brief Merge arr[left, middle) and arr[middle, right) without a buffer.
+ */
+void merge_sort_merge_in_place(int *arr, int left, int middle, int right);
+
+/**
+ * @brief Swap the blocks arr[left, middle) and arr[middle, right).
+ */
+void merge_sort_rotate(int *arr, int left, int middle, int right);
+
+/**
+ * @brief Sort an array with merge_sort() or merge_sort_in_place(). The
+ * buffered mode falls back to the in-place sort if out of memory.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param mode CDSA_MERGE_SORT_MODE_BUFFERED or CDSA_MERGE_SORT_MODE_IN_PLACE
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if arr is
+ * NULL
+ */
+int merge_sort_with_mode(int arr_count, int *arr, int mode);
+
+/**
+ * @brief Sort a binary file of native ints, keeping at most memory_count of
+ * them in memory.
+ * 
+ * @param input_path Path of the input file
+ * @param output_path Path of the output file
+ * @param memory_count Number of ints kept in memory
+ * @return CDSA_MERGE_SORT_OK if success, otherwise an error code
+ */
+int merge_sort_external(
+    const char *input_path,
+    const char *output_path,
+    int memory_count
+);
+
+/**
+ * @brief Stably sort count elements of size bytes with a qsort()-style
+ * comparator.
+ * 
+ * @return CDSA_MERGE_SORT_OK if success, otherwise an error code
+ */
+int merge_sort_generic(
+    void *base,
+    size_t count,
+    size_t size,
+    int (*compare)(const void *, const void *)
+);
+
+/**
+ * @brief Compute the stable sorting permutation of an array of keys:
+ * keys[indices[0]], keys[indices[1]], ... are in order, and equal keys keep the
+ * order of their indices. The keys are left unchanged.
+ * 
+ * @param arr_count Size of the array
+ * @param keys The keys
+ * @param indices Where to store the arr_count indices
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if keys or
+ * indices is NULL, otherwise CDSA_MERGE_SORT_ALLOC_FAILED
+ */
+int merge_sort_argsort(int arr_count, const int *keys, int *indices);
+
+/**
+ * @brief Stably sort an array of keys, and reorder a parallel array of
+ * payload elements of payload_size bytes the same way.
+ * 
+ * @param arr_count Size of both arrays
+ * @param keys The keys
+ * @param payload The payload, element i going with keys[i]
+ * @param payload_size Size in bytes of a payload element
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if keys or
+ * payload is NULL, otherwise CDSA_MERGE_SORT_ALLOC_FAILED
+ */
+int merge_sort_by_key(
+    int arr_count,
+    int *keys,
+    void *payload,
+    size_t payload_size
+);
+
+/**
+ * @brief Create a new, empty merge sort stream.
+ * 
+ * @return The stream, or NULL if failed to allocate
+ */
+MergeSortStream *new_merge_sort_stream();
+
+/**
+ * @brief Sort a batch into the stream. Fails once the stream is finished.
+ * 
+ * @param stream The stream
+ * @param batch_count Size of the batch
+ * @param batch The batch
+ * @return CDSA_MERGE_SORT_OK if success, otherwise an error code
+ */
+int merge_sort_stream_feed(
+    MergeSortStream *stream,
+    int batch_count,
+    const int *batch
+);
+
+/**
+ * @brief End the input of the stream and prepare the sorted output.
+ * 
+ * @param stream The stream
+ * @return CDSA_MERGE_SORT_OK if success, otherwise an error code
+ */
+int merge_sort_stream_finish(MergeSortStream *stream);
+
+/**
+ * @brief Pop the smallest element left in a finished stream.
+ * 
+ * @param stream The stream
+ * @param data_ref Where to store the element
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_EMPTY if no
+ * element is left, otherwise an error code
+ */
+int merge_sort_stream_next_sorted(MergeSortStream *stream, int *data_ref);
+
+/**
+ * @brief Free a merge sort stream and set the reference to NULL.
+ * 
+ * @param stream_ref Reference of the stream
+ * @return CDSA_MERGE_SORT_OK if success, CDSA_MERGE_SORT_NULL if the
+ * reference is NULL
+ */
+int destroy_merge_sort_stream(MergeSortStream **stream_ref);
+
+#endif /* CDSA_MERGE_SORT_H */
@@ -0,0 +1,37 @@
+/**
+ * @file partial_sort.h
+ * @author HN Thap
+ * @brief Partial sort (top-k) and selection for int arrays (see
+ * src/partial_sort.c).
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_PARTIAL_SORT_H
+#define CDSA_PARTIAL_SORT_H
+
+/**
+ * @brief Sort the k smallest elements of an array into arr[0, k), leaving
+ * the other elements in arr[k, arr_count) in unspecified order. k is capped
+ * to arr_count.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param k Number of smallest elements to sort
+ */
+void partial_sort(int arr_count, int *arr, int k);
+
+/**
+ * @brief Rearrange an array so that arr[nth] is the element that would be
+ * there if the array was sorted, with no greater element before it and no
+ * smaller one after it.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param nth Position to select, in [0, arr_count)
+ */
+void partial_sort_nth_element(int arr_count, int *arr, int nth);
+
+#endif /* CDSA_PARTIAL_SORT_H */
@@ -0,0 +1,62 @@
+/**
+ * @file radix_sort.h
+ * @author HN Thap
+ * @brief Radix sort and counting sort for int keys (see src/radix_sort.c).
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_RADIX_SORT_H
+#define CDSA_RADIX_SORT_H
+
+/**
+ * @brief Largest number of distinct values for which radix_sort() falls
+ * back to counting sort (the counts take 4 MiB at most).
+ */
+#define CDSA_RADIX_SORT_COUNTING_MAX_RANGE (1 << 20)
+
+/**
+ * @brief Arrays of this many elements or fewer are sorted on the calling
+ * thread only by radix_sort_parallel().
+ */
+#define CDSA_RADIX_SORT_PARALLEL_GRAIN (65536)
+
+/**
+ * @brief Maximum number of threads used by radix_sort_parallel().
+ */
+#define CDSA_RADIX_SORT_MAX_THREADS (256)
+
+/**
+ * @brief Perform LSD radix sort on an array in-place, or counting sort when
+ * the values span a small range.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ */
+void radix_sort(int arr_count, int *arr);
+
+/**
+ * @brief Perform counting sort on an array in-place. Values must lie in
+ * [min_value, max_value]; a span above CDSA_RADIX_SORT_COUNTING_MAX_RANGE
+ * is sorted by radix_sort() instead.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param min_value Smallest value in the array
+ * @param max_value Largest value in the array
+ */
+void radix_sort_counting(int arr_count, int *arr, int min_value, int max_value);
+
+/**
+ * @brief Perform MSD radix sort on an array in-place with up to num_threads
+ * threads (the calling thread included).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ */
+void radix_sort_parallel(int arr_count, int *arr, int num_threads);
+
+#endif /* CDSA_RADIX_SORT_H */
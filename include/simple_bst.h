@@ -0,0 +1,425 @@
+/**
+ * @file simple_bst.h
+ * @author HN Thap
+ * @brief Simple, unbalanced binary search tree (see src/simple_bst.c).
+ * 
+ * Define CDSA_SIMPLE_BST_ORDER_STATISTICS the same way for the library and
+ * the code including this header, since it changes the layout of BSTNode.
+ * 
+ * @version 0.1
+ * @date 2025-08-11
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_SIMPLE_BST_H
+#define CDSA_SIMPLE_BST_H
+
+/**
+ * @brief Return code for BST that indicates success.
+ */
+#define CDSA_SIMPLE_BST_OK (0)
+/**
+ * @brief Return code for BST that indicates failure.
+ */
+#define CDSA_SIMPLE_BST_FAILED (1)
+/**
+ * @brief Return code for BST that indicates errors involving NULL.
+ */
+#define CDSA_SIMPLE_BST_NULL (2)
+/**
+ * @brief Return code for BST that indicates errors involving empty
+ * containers.
+ */
+#define CDSA_SIMPLE_BST_EMPTY (3)
+/**
+ * @brief Return code for BST that indicates allocation failure.
+ */
+#define CDSA_SIMPLE_BST_ALLOC_FAILED (4)
+/**
+ * @brief Return code for BST that indicates a failed search operation,
+ * i.e. item is not found.
+ */
+#define CDSA_SIMPLE_BST_NOT_FOUND (5)
+
+/**
+ * @brief Number of pending nodes a BST iterator can hold. Only ancestors
+ * whose key is still to be yielded are held, so more are only needed on left
+ * spines longer than this, such as the chains left by pushing many equal or
+ * decreasing keys. The iterator then drops the farthest ones, and descends
+ * again from the root when it runs out of pending nodes.
+ */
+#define CDSA_SIMPLE_BST_ITERATOR_DEPTH (64)
+
+#if defined(CDSA_SIMPLE_BST_STATS)
+/**
+ * @brief Counters of the instrumented build.
+ */
+typedef struct SimpleBSTStats
+{
+    unsigned long allocations; /* Nodes allocated by new_bst_node() */
+    unsigned long frees; /* Nodes freed */
+    unsigned long max_depth; /* Deepest node pushed, the root being 1 */
+} SimpleBSTStats;
+
+extern SimpleBSTStats simple_bst_stats;
+#endif
+
+/*
+ * Order statistics. Define CDSA_SIMPLE_BST_ORDER_STATISTICS to keep the size
+ * of every subtree in its root, which select_kth_bst() and rank_of_bst()
+ * use to answer in O(h) instead of a full traversal. Every push and pop then
+ * also updates the sizes along its path.
+ */
+
+/**
+ * @brief Basic structure for a BST node.
+ */
+typedef struct BSTNode
+{
+    int data;
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+    int size; /* Number of nodes in the subtree rooted here */
+#endif
+    struct BSTNode *left;
+    struct BSTNode *right;
+} BSTNode;
+
+/**
+ * @brief Basic structure for a BST.
+ */
+typedef struct BST
+{
+    BSTNode *root;
+} BST;
+
+/**
+ * @brief Read-only snapshot of a BST in Eytzinger (BFS) order: the children
+ * of keys[k] are keys[2k] and keys[2k + 1], so no pointers are stored and
+ * the top levels of every search share the same few cache lines.
+ */
+typedef struct FrozenBST
+{
+    int *keys; /* keys[1..count], keys[0] is unused */
+    int count;
+} FrozenBST;
+
+/**
+ * @brief Allocation-free in-order iterator over the keys in [lo, hi] of a
+ * BST. It is invalidated by any change to the tree.
+ * 
+ * The pending nodes are kept in a ring, so that pushing to a full stack
+ * drops the bottom one. The iterator then remembers the last key yielded
+ * and how many copies of it were, to find where it was from the root.
+ */
+typedef struct BSTIterator
+{
+    const BSTNode *root;
+    const BSTNode *stack[CDSA_SIMPLE_BST_ITERATOR_DEPTH];
+    int bottom; /* Index of the bottom entry of the stack */
+    int top; /* Number of entries in the stack */
+    int truncated; /* Non-zero if entries were dropped since the descent */
+    int hi;
+    int last; /* Last key yielded */
+    int last_copies; /* Copies of it yielded, 0 if nothing was yet */
+} BSTIterator;
+
+/**
+ * @brief Allocate and initialize new BST node.
+ * 
+ * @param data Data
+ * @param left Pointer to left child (NULL if not presenting)
+ * @param right Pointer to right child (NULL if not presenting)
+ * @return BSTNode* Pointer to new allocated block,
+ * otherwise, NULL when allocation fails
+ */
+BSTNode *new_bst_node(int data, BSTNode *left, BSTNode *right);
+
+/**
+ * @brief Allocate and initialize an empty BST.
+ * 
+ * @return BST* Pointer to new allocated block,
+ * otherwise, NULL when allocation fails
+ */
+BST *new_bst();
+
+/**
+ * @brief Build a height-balanced BST from a sorted array in O(n). The middle
+ * element of each range becomes the subtree root, so equal values may end up
+ * on either side of each other; search_bst() and pop_bst() are unaffected.
+ * 
+ * @param arr Pointer to array sorted in non-decreasing order
+ * @param n Array size
+ * @return BST* Pointer to new allocated BST,
+ * otherwise, NULL when the input is invalid or allocation fails.
+ */
+BST *build_bst_from_sorted(const int *arr, int n);
+
+/**
+ * @brief Recursively build the subtree for a sorted range (particularly used
+ * inside build_bst_from_sorted()).
+ * 
+ * @param arr Pointer to the first element of the range
+ * @param n Range size
+ * @param node_ref Reference of the pointer to the subtree's root
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_ALLOC_FAILED (nothing is left allocated).
+ */
+int build_bst_from_sorted_recursive(
+    const int *arr,
+    int n,
+    BSTNode **node_ref
+);
+
+/**
+ * @brief Push new node to a BST. If the inserted value has already existed
+ * in the tree, a new node with that value would be pushed to the left subtree
+ * of the existing node with the same value.
+ * 
+ * @param tree Pointer to BST
+ * @param data Data to be stored
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * or, CDSA_SIMPLE_BST_NULL if tree pointer is NULL,
+ * otherwise, CDSA_SIMPLE_BST_ALLOC_FAILED when failed to allocate node.
+ */
+int push_bst(BST *tree, int data);
+
+/**
+ * @brief Push many values to a BST, interleaving the descents of up to
+ * CDSA_SIMPLE_BST_BATCH_GROUP values with software prefetching. The result
+ * is a valid BST holding the same values as pushing them one by one.
+ * 
+ * @param tree Pointer to BST
+ * @param keys Pointer to values to be stored
+ * @param n Number of values
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * or, CDSA_SIMPLE_BST_NULL if tree or keys pointer is NULL,
+ * otherwise, CDSA_SIMPLE_BST_ALLOC_FAILED when failed to allocate node
+ * (the tree stays valid, but only part of the values have been pushed).
+ */
+int push_bst_batch(BST *tree, const int *keys, int n);
+
+/**
+ * @brief Search for node to delete. Particularly used inside pop_bst(), never
+ * use it anywhere else except you have a ridiculously good reason.
+ * 
+ * @param tree Pointer to BST (This has to be not NULL, otherwise, undefined
+ * behavior is warranted.)
+ * @param data Data to delete
+ * @param parent_ref Reference of pointer to parent
+ * @param node_ref Reference of pointer to node
+ * @param is_right_child_ref Reference to value indicating whether the node to
+ * delete is a right child of another (ignored when node to delete is root)
+ * @return CDSA_SIMPLE_BST_OK if found,
+ * otherwise, CDSA_SIMPLE_BST_NOT_FOUND when not found.
+ */
+int pop_bst_search(
+    BST *tree,
+    int data,
+    BSTNode **parent_ref,
+    BSTNode **node_ref,
+    unsigned char *is_right_child_ref
+);
+
+/**
+ * @brief Pop (delete) node from a BST.
+ * 
+ * @param tree Pointer to tree
+ * @param data Data to delete
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * or, CDSA_SIMPLE_BST_NOT_FOUND if the value to data is not found,
+ * otherwise, CDSA_SIMPLE_BST_NULL if tree pointer is NULL.
+ */
+int pop_bst(BST *tree, int data);
+
+/**
+ * @brief Search data inside a BST.
+ * 
+ * @param tree Pointer to BST
+ * @param data Data to search
+ * @return int CDSA_SIMPLE_BST_OK if found,
+ * or CDSA_SIMPLE_BST_NOT_FOUND if not found,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the tree pointer is NULL.
+ */
+int search_bst(const BST *tree, int data);
+
+/**
+ * @brief Search many values inside a BST, interleaving the descents of up to
+ * CDSA_SIMPLE_BST_BATCH_GROUP values with software prefetching.
+ * 
+ * @param tree Pointer to BST
+ * @param keys Pointer to values to search
+ * @param n Number of values
+ * @param results Pointer to n results, each set to CDSA_SIMPLE_BST_OK if the
+ * value is found, otherwise, CDSA_SIMPLE_BST_NOT_FOUND
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when a pointer is NULL.
+ */
+int search_bst_batch(const BST *tree, const int *keys, int n, int *results);
+
+/**
+ * @brief Freeze a BST into a pointer-free Eytzinger layout. The tree itself
+ * is left unchanged, and later changes to it are not reflected.
+ * 
+ * @param tree Pointer to BST
+ * @return FrozenBST* Pointer to new allocated snapshot,
+ * otherwise, NULL when the tree pointer is NULL or allocation fails.
+ */
+FrozenBST *freeze_bst(const BST *tree);
+
+/**
+ * @brief Search data inside a frozen BST with a branchless descent that
+ * prefetches four levels ahead.
+ * 
+ * @param frozen Pointer to frozen BST
+ * @param data Data to search
+ * @return int CDSA_SIMPLE_BST_OK if found,
+ * or CDSA_SIMPLE_BST_NOT_FOUND if not found,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the frozen BST pointer is NULL.
+ */
+int search_frozen_bst(const FrozenBST *frozen, int data);
+
+/**
+ * @brief Destroy a frozen BST.
+ * 
+ * @param frozen_ref Reference of the pointer to frozen BST
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the reference is NULL.
+ */
+int destroy_frozen_bst(FrozenBST **frozen_ref);
+
+/**
+ * @brief Position an iterator at the first key in [lo, hi] of a BST.
+ * Subtrees entirely outside the range are never visited, so a whole range
+ * query touches O(h + k) nodes for a tree of height h and k results, plus one
+ * more descent per CDSA_SIMPLE_BST_ITERATOR_DEPTH results on longer left
+ * spines.
+ * 
+ * @param tree Pointer to BST
+ * @param lo Smallest key to yield
+ * @param hi Largest key to yield
+ * @param iterator Pointer to iterator
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when a pointer is NULL.
+ */
+int seek_bst_iterator(
+    const BST *tree,
+    int lo,
+    int hi,
+    BSTIterator *iterator
+);
+
+/**
+ * @brief Yield the next keys of an iterator, in non-decreasing order, into a
+ * caller-provided buffer.
+ * 
+ * @param iterator Pointer to iterator
+ * @param out Pointer to buffer
+ * @param capacity Maximum number of keys to yield
+ * @param count_ref Reference to the number of keys yielded (0 once the
+ * iterator is exhausted)
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when a pointer is NULL.
+ */
+int next_bst_iterator(
+    BSTIterator *iterator,
+    int *out,
+    int capacity,
+    int *count_ref
+);
+
+/**
+ * @brief Copy the keys in [lo, hi] of a BST into a buffer, in non-decreasing
+ * order. At most capacity keys are copied; an iterator from
+ * seek_bst_iterator() retrieves any number of them lazily instead.
+ * 
+ * @param tree Pointer to BST
+ * @param lo Smallest key to copy
+ * @param hi Largest key to copy
+ * @param out Pointer to buffer
+ * @param capacity Buffer size
+ * @param count_ref Reference to the number of keys copied
+ * @return int Same as seek_bst_iterator()
+ */
+int range_bst(
+    const BST *tree,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+);
+
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+/**
+ * @brief Retrieve the k-th smallest key of a BST (only with
+ * CDSA_SIMPLE_BST_ORDER_STATISTICS).
+ * 
+ * @param tree Pointer to BST
+ * @param k Zero-based position of the key in sorted order
+ * @param data_ref Reference to the retrieved key
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * or, CDSA_SIMPLE_BST_NOT_FOUND if k is out of range,
+ * otherwise, CDSA_SIMPLE_BST_NULL when a pointer is NULL.
+ */
+int select_kth_bst(const BST *tree, int k, int *data_ref);
+
+/**
+ * @brief Retrieve the rank of a value in a BST, i.e. the number of keys less
+ * than it (only with CDSA_SIMPLE_BST_ORDER_STATISTICS). When the value is
+ * stored, select_kth_bst() with that rank retrieves it.
+ * 
+ * @param tree Pointer to BST
+ * @param data Value to rank (it does not have to be stored)
+ * @param rank_ref Reference to the rank
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when a pointer is NULL.
+ */
+int rank_of_bst(const BST *tree, int data, int *rank_ref);
+#endif
+
+/**
+ * @brief Clear a BST node and all of its children (particularly used inside
+ * clear_bst()). Despite the name, kept for compatibility, it does not
+ * recurse: the nodes are rotated into a list and freed in O(1) extra memory.
+ * 
+ * @param node Pointer to BST node.
+ */
+void clear_bst_recursive(BSTNode *node);
+
+/**
+ * @brief Clear a BST (without destroying it).
+ * 
+ * @param tree Pointer to BST
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the tree pointer is NULL.
+ */
+int clear_bst(BST *tree);
+
+/**
+ * @brief Destroy a BST.
+ * 
+ * @param tree_ref Reference of the pointer to BST
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the BST reference is NULL.
+ */
+int destroy_bst(BST **tree_ref);
+
+/**
+ * @brief Print an BST node and its children recursively sideways to standard
+ * output (particularly used inside print_bst_sideways()).
+ * 
+ * @param node Pointer to node
+ * @param level Node level
+ */
+void print_bst_sideways_recursive(const BSTNode *node, int level);
+
+/**
+ * @brief Print an BST tree sideways to standard output.
+ * 
+ * @param tree Pointer to tree
+ * @return CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL if tree pointer is NULL
+ */
+int print_bst_sideways(const BST *tree);
+
+#endif /* CDSA_SIMPLE_BST_H */
@@ -0,0 +1,125 @@
+/**
+ * @file sort_io.h
+ * @author HN Thap
+ * @brief Fast file input and output of int arrays for the command line
+ * sorters (see src/sort_io.c).
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_SORT_IO_H
+#define CDSA_SORT_IO_H
+
+#include <stddef.h>
+
+/**
+ * @brief Return code for sort I/O that indicates success.
+ */
+#define CDSA_SORT_IO_OK (0)
+
+/**
+ * @brief Return code for sort I/O that indicates a failed read, write or
+ * open, or a file too large for an int count.
+ */
+#define CDSA_SORT_IO_FAILED (1)
+
+/**
+ * @brief Return code for sort I/O that indicates errors involving NULL.
+ */
+#define CDSA_SORT_IO_NULL (2)
+
+/**
+ * @brief Return code for sort I/O that indicates allocation failure.
+ */
+#define CDSA_SORT_IO_ALLOC_FAILED (4)
+
+/**
+ * @brief Return code for sort I/O that indicates malformed input: a binary
+ * file whose size is not a multiple of sizeof(int), or a text token that is
+ * not an int.
+ */
+#define CDSA_SORT_IO_INVALID (5)
+
+/**
+ * @brief File format: raw native-endian ints (int32 on every supported
+ * platform), as read and written by merge_sort_external().
+ */
+#define CDSA_SORT_IO_FORMAT_BINARY (0)
+
+/**
+ * @brief File format: decimal ints separated by whitespace, written one per
+ * line.
+ */
+#define CDSA_SORT_IO_FORMAT_TEXT (1)
+
+/**
+ * @brief Size in bytes of the buffers of the text parser and formatter.
+ */
+#define CDSA_SORT_IO_BUFFER_SIZE (65536)
+
+/**
+ * @brief An int array read by sort_io_read().
+ * 
+ * A binary file is mapped privately when the platform allows it: data then
+ * points into the mapping, which can be sorted in-place without touching
+ * the file. Otherwise, data is allocated.
+ */
+typedef struct SortIOArray
+{
+    int *data;
+    int count;
+    int capacity; /* Allocated ints, 0 when data is mapped */
+    void *mapping; /* Start of the mapping, NULL when data is allocated */
+    size_t mapping_size;
+} SortIOArray;
+
+/**
+ * @brief Read a whole file of ints. The path "-" reads the standard input.
+ * 
+ * @param path Path of the file
+ * @param format CDSA_SORT_IO_FORMAT_BINARY or CDSA_SORT_IO_FORMAT_TEXT
+ * @param array Where to store the array, to be released by
+ * sort_io_release() (only on success)
+ * @return int CDSA_SORT_IO_OK if success,
+ * or CDSA_SORT_IO_NULL if path or array is NULL,
+ * or CDSA_SORT_IO_INVALID if the file is malformed or format is unknown,
+ * or CDSA_SORT_IO_ALLOC_FAILED if failed to allocate the array,
+ * otherwise, CDSA_SORT_IO_FAILED.
+ */
+int sort_io_read(const char *path, int format, SortIOArray *array);
+
+/**
+ * @brief Write an int array to a file. The path "-" writes the standard
+ * output.
+ * 
+ * @param path Path of the file
+ * @param format CDSA_SORT_IO_FORMAT_BINARY or CDSA_SORT_IO_FORMAT_TEXT
+ * @param count Size of the array
+ * @param data The array
+ * @return int CDSA_SORT_IO_OK if success,
+ * or CDSA_SORT_IO_NULL if path or data is NULL,
+ * or CDSA_SORT_IO_INVALID if format is unknown,
+ * otherwise, CDSA_SORT_IO_FAILED.
+ */
+int sort_io_write(const char *path, int format, int count, const int *data);
+
+/**
+ * @brief Unmap or free an array read by sort_io_read(), and reset it.
+ * 
+ * @param array The array
+ */
+void sort_io_release(SortIOArray *array);
+
+/**
+ * @brief Translate a command line option into a format.
+ * 
+ * @param option "--binary" or "--text"
+ * @param format_ref Where to store the format
+ * @return int CDSA_SORT_IO_OK if success,
+ * otherwise, CDSA_SORT_IO_INVALID.
+ */
+int sort_io_parse_format(const char *option, int *format_ref);
+
+#endif /* CDSA_SORT_IO_H */
@@ -0,0 +1,188 @@
+/**
+ * @file tree_sort.h
+ * @author HN Thap
+ * @brief Tree sort with BST, AVL and B+ tree backends (see src/tree_sort.c).
+ * The AVL backend links against avl_tree.c.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_TREE_SORT_H
+#define CDSA_TREE_SORT_H
+
+/**
+ * @brief Return code for tree sort that indicates success.
+ */
+#define CDSA_TREE_SORT_OK (0)
+
+/**
+ * @brief Return code for tree sort that indicates failure.
+ */
+#define CDSA_TREE_SORT_FAILED (1)
+
+/**
+ * @brief Return code for tree sort that indicates errors involving NULL.
+ */
+#define CDSA_TREE_SORT_NULL (2)
+
+/**
+ * @brief Return code for tree sort that indicates errors involving empty
+ * containers.
+ */
+#define CDSA_TREE_SORT_EMPTY (3)
+
+/**
+ * @brief Return code for tree sort that indicates allocation failure.
+ */
+#define CDSA_TREE_SORT_ALLOC_FAILED (4)
+
+/**
+ * @brief Return code of push_bst_bounded() when a key had to be dropped to
+ * stay within the limit.
+ */
+#define CDSA_TREE_SORT_DROPPED (5)
+
+/**
+ * @brief Tree sort backend: simple, unbalanced BST.
+ */
+#define CDSA_TREE_SORT_BACKEND_BST (0)
+
+/**
+ * @brief Tree sort backend: AVL tree.
+ */
+#define CDSA_TREE_SORT_BACKEND_AVL (1)
+
+/**
+ * @brief Tree sort backend: B+ tree with cache-line sized nodes.
+ */
+#define CDSA_TREE_SORT_BACKEND_BPLUS (2)
+
+#if defined(CDSA_TREE_SORT_STATS)
+/**
+ * @brief Counters of the instrumented build.
+ */
+typedef struct TreeSortStats
+{
+    unsigned long allocations; /* Heap blocks allocated */
+    unsigned long frees; /* Heap blocks freed */
+    unsigned long max_depth; /* Deepest BST node reached, the root being 1 */
+} TreeSortStats;
+
+extern TreeSortStats tree_sort_stats;
+#endif
+
+/**
+ * @brief Perform Tree sort on an array in-place.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int CDSA_TREE_SORT_OK if success,
+ * or CDSA_TREE_SORT_ALLOC_FAILED if failed to allocate memory,
+ * otherwise, CDSA_TREE_SORT_FAILED, which indicates failure from
+ * push_bst().
+ */
+int tree_sort(int arr_count, int arr[]);
+
+/**
+ * @brief Perform Tree sort on an array in-place with the simple BST.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int Same as tree_sort()
+ */
+int tree_sort_bst(int arr_count, int arr[]);
+
+/**
+ * @brief Sort only the k smallest elements of an array into arr[0, k), with
+ * a simple BST bounded to k keys by push_bst_bounded(). The other elements
+ * are left in arr[k, arr_count), in unspecified order. k is capped to
+ * arr_count.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param k Number of smallest elements to sort
+ * @return int Same as tree_sort()
+ */
+int tree_sort_partial(int arr_count, int arr[], int k);
+
+/**
+ * @brief Perform Tree sort on an array in-place with an AVL tree. All nodes
+ * are allocated in one block.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int CDSA_TREE_SORT_OK if success,
+ * or CDSA_TREE_SORT_NULL if arr is NULL,
+ * otherwise, CDSA_TREE_SORT_ALLOC_FAILED if failed to allocate memory.
+ */
+int tree_sort_avl(int arr_count, int arr[]);
+
+/**
+ * @brief Perform Tree sort on an array in-place with a B+ tree
+ * (b_plus_tree.c), then read the keys back along the linked leaves. All
+ * nodes are allocated in two blocks (new_bplus_tree_with_arena()).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int CDSA_TREE_SORT_OK if success,
+ * or CDSA_TREE_SORT_NULL if arr is NULL,
+ * or CDSA_TREE_SORT_ALLOC_FAILED if failed to allocate memory,
+ * otherwise, CDSA_TREE_SORT_FAILED, which indicates failure from
+ * push_bplus_tree().
+ */
+int tree_sort_bplus(int arr_count, int arr[]);
+
+/**
+ * @brief Perform Tree sort on an array in-place with the chosen backend.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param backend CDSA_TREE_SORT_BACKEND_BST, CDSA_TREE_SORT_BACKEND_AVL or
+ * CDSA_TREE_SORT_BACKEND_BPLUS
+ * @return int Same as tree_sort(),
+ * or CDSA_TREE_SORT_FAILED if the backend is unknown.
+ */
+int tree_sort_with_backend(int arr_count, int arr[], int backend);
+
+/**
+ * @brief Perform Tree sort on an array in-place with the AVL backend and up
+ * to num_threads threads (the calling thread included), see
+ * tree_sort_parallel_with_backend(). The AVL tree keeps every bucket
+ * O(n log n) on presorted input, on which the simple BST is quadratic.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ * @return int Same as tree_sort_parallel_with_backend()
+ */
+int tree_sort_parallel(int arr_count, int arr[], int num_threads);
+
+/**
+ * @brief Perform Tree sort on an array in-place with the chosen backend and
+ * up to num_threads threads (the calling thread included).
+ * 
+ * Splitters drawn from a sample of the array partition the keys into one
+ * bucket per thread. Each thread then builds the tree of its bucket, with
+ * its own node arena, and writes it in order right at the bucket's offset in
+ * arr. Arrays too small to give every thread CDSA_TREE_SORT_PARALLEL_MIN_BUCKET
+ * keys (see the source) use fewer threads, or none.
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ * @param backend CDSA_TREE_SORT_BACKEND_BST, CDSA_TREE_SORT_BACKEND_AVL or
+ * CDSA_TREE_SORT_BACKEND_BPLUS
+ * @return int Same as tree_sort(),
+ * or CDSA_TREE_SORT_FAILED if the backend is unknown. On failure, arr holds
+ * the same keys in unspecified order.
+ */
+int tree_sort_parallel_with_backend(
+    int arr_count,
+    int arr[],
+    int num_threads,
+    int backend
+);
+
+#endif /* CDSA_TREE_SORT_H */
@@ -0,0 +1,113 @@
+/**
+ * @file tree_sort_no_recursion.h
+ * @author HN Thap
+ * @brief Aliases of the Tree sort functions of tree_sort.h under the
+ * tree_sort_no_recursion prefix (see src/tree_sort_no_recursion.c).
+ * 
+ * tree_sort.c is recursion-free itself, so these only forward to it, and
+ * share its return codes, backends and instrumentation counters. Link
+ * against tree_sort.c too.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#ifndef CDSA_TREE_SORT_NO_RECURSION_H
+#define CDSA_TREE_SORT_NO_RECURSION_H
+
+#include "tree_sort.h"
+
+#if defined(CDSA_TREE_SORT_STATS)
+/**
+ * @brief Counters of the instrumented build (see TreeSortStats), shared with
+ * tree_sort.c which does the work.
+ */
+#define tree_sort_no_recursion_stats tree_sort_stats
+#endif
+
+/**
+ * @brief Alias of tree_sort() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int Same as tree_sort()
+ */
+int tree_sort_no_recursion(int arr_count, int arr[]);
+
+/**
+ * @brief Alias of tree_sort_bst() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int Same as tree_sort_bst()
+ */
+int tree_sort_no_recursion_bst(int arr_count, int arr[]);
+
+/**
+ * @brief Alias of tree_sort_partial() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param k Number of smallest elements to sort
+ * @return int Same as tree_sort_partial()
+ */
+int tree_sort_no_recursion_partial(int arr_count, int arr[], int k);
+
+/**
+ * @brief Alias of tree_sort_avl() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int Same as tree_sort_avl()
+ */
+int tree_sort_no_recursion_avl(int arr_count, int arr[]);
+
+/**
+ * @brief Alias of tree_sort_bplus() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @return int Same as tree_sort_bplus()
+ */
+int tree_sort_no_recursion_bplus(int arr_count, int arr[]);
+
+/**
+ * @brief Alias of tree_sort_with_backend() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param backend CDSA_TREE_SORT_BACKEND_BST, CDSA_TREE_SORT_BACKEND_AVL or
+ * CDSA_TREE_SORT_BACKEND_BPLUS
+ * @return int Same as tree_sort_with_backend()
+ */
+int tree_sort_no_recursion_with_backend(int arr_count, int arr[], int backend);
+
+/**
+ * @brief Alias of tree_sort_parallel() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ * @return int Same as tree_sort_parallel()
+ */
+int tree_sort_no_recursion_parallel(int arr_count, int arr[], int num_threads);
+
+/**
+ * @brief Alias of tree_sort_parallel_with_backend() (see tree_sort.h).
+ * 
+ * @param arr_count Size of the array
+ * @param arr The array
+ * @param num_threads Number of threads
+ * @param backend CDSA_TREE_SORT_BACKEND_BST, CDSA_TREE_SORT_BACKEND_AVL or
+ * CDSA_TREE_SORT_BACKEND_BPLUS
+ * @return int Same as tree_sort_parallel_with_backend()
+ */
+int tree_sort_no_recursion_parallel_with_backend(
+    int arr_count,
+    int arr[],
+    int num_threads,
+    int backend
+);
+
+#endif /* CDSA_TREE_SORT_NO_RECURSION_H */
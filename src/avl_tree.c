@@ -0,0 +1,715 @@
+/**
+ * @file avl_tree.c
+ * @author HN Thap
+ * @brief Simple implementation of AVL Tree with iterative insertion, search
+ * and deletion.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "avl_tree.h"
+
+/**
+ * @brief Hint the processor to start loading memory into cache.
+ */
+#if defined(__GNUC__)
+#define CDSA_AVL_TREE_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define CDSA_AVL_TREE_PREFETCH(p) ((void)(p))
+#endif
+
+/*
+ * Instrumentation. Define CDSA_AVL_TREE_STATS to count the single rotations
+ * in the global avl_tree_stats (a double rotation counts as two).
+ * Otherwise, the counting macro expands to nothing.
+ */
+#if defined(CDSA_AVL_TREE_STATS)
+AVLTreeStats avl_tree_stats;
+
+#define CDSA_AVL_TREE_COUNT(field) ((void)(avl_tree_stats.field += 1))
+#else
+#define CDSA_AVL_TREE_COUNT(field) ((void)0)
+#endif
+
+/**
+ * @brief Recursively build the subtree for a sorted range (particularly used
+ * inside build_avl_from_sorted()).
+ * 
+ * @param arr Pointer to the first element of the range
+ * @param n Range size
+ * @param height_ref Reference to the built subtree's height
+ * @param node_ref Reference of the pointer to the subtree's root
+ * @return int Non-zero if success, zero when allocation fails (nothing is
+ * left allocated).
+ */
+static int build_avl_from_sorted_range(
+    const int *arr,
+    int n,
+    int *height_ref,
+    AVLNode **node_ref
+);
+
+/**
+ * @brief Fix a subtree whose left side is two levels taller than its right.
+ * 
+ * @param link Reference of the pointer to the subtree's root
+ * @return int Non-zero if the subtree got one level shorter than before
+ * the imbalance, zero if it kept that height (deletion only).
+ */
+static int avl_fix_left_heavy(AVLNode **link);
+
+/**
+ * @brief Fix a subtree whose right side is two levels taller than its left.
+ * 
+ * @param link Reference of the pointer to the subtree's root
+ * @return int Non-zero if the subtree got one level shorter than before
+ * the imbalance, zero if it kept that height (deletion only).
+ */
+static int avl_fix_right_heavy(AVLNode **link);
+
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+/**
+ * @brief Retrieve the subtree size of a node, 0 when the node is NULL.
+ */
+static int avl_size(const AVLNode *node);
+#endif
+
+AVLNode *new_avl_node(int data, int balance, AVLNode *left, AVLNode *right)
+{
+    AVLNode *node = malloc(sizeof(AVLNode));
+    if (node == NULL)
+    {
+        fprintf(stderr, "Failed to initialize AVL node: allocation failure.\n");
+        return NULL;
+    }
+    node->data = data;
+    node->balance = balance;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    node->size = 1 + avl_size(left) + avl_size(right);
+#endif
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+static int avl_size(const AVLNode *node)
+{
+    return node ? node->size : 0;
+}
+#endif
+
+int get_avl_height(AVLNode *node)
+{
+    int height = 0;
+    while (node)
+    {
+        height += 1;
+        node = (node->balance < 0) ? node->right : node->left;
+    }
+    return height;
+}
+
+int get_avl_balance(AVLNode *node)
+{
+    return node ? node->balance : 0;
+}
+
+AVLNode *right_rotate_avl(AVLNode *y)
+{
+    AVLNode *x = y->left;
+    CDSA_AVL_TREE_COUNT(right_rotations);
+    y->left = x->right;
+    x->right = y;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    x->size = y->size;
+    y->size = 1 + avl_size(y->left) + avl_size(y->right);
+#endif
+    return x;
+}
+
+AVLNode *left_rotate_avl(AVLNode *x)
+{
+    AVLNode *y = x->right;
+    CDSA_AVL_TREE_COUNT(left_rotations);
+    x->right = y->left;
+    y->left = x;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    y->size = x->size;
+    x->size = 1 + avl_size(x->left) + avl_size(x->right);
+#endif
+    return y;
+}
+
+static int avl_fix_left_heavy(AVLNode **link)
+{
+    AVLNode *current = *link;
+    AVLNode *left = current->left;
+    AVLNode *pivot;
+    if (left->balance >= 0)
+    {
+        *link = right_rotate_avl(current);
+        if (left->balance == 0)
+        {
+            current->balance = 1;
+            left->balance = -1;
+            return 0;
+        }
+        current->balance = 0;
+        left->balance = 0;
+        return 1;
+    }
+    pivot = left->right;
+    current->left = left_rotate_avl(left);
+    *link = right_rotate_avl(current);
+    current->balance = (pivot->balance > 0) ? -1 : 0;
+    left->balance = (pivot->balance < 0) ? 1 : 0;
+    pivot->balance = 0;
+    return 1;
+}
+
+static int avl_fix_right_heavy(AVLNode **link)
+{
+    AVLNode *current = *link;
+    AVLNode *right = current->right;
+    AVLNode *pivot;
+    if (right->balance <= 0)
+    {
+        *link = left_rotate_avl(current);
+        if (right->balance == 0)
+        {
+            current->balance = -1;
+            right->balance = 1;
+            return 0;
+        }
+        current->balance = 0;
+        right->balance = 0;
+        return 1;
+    }
+    pivot = right->left;
+    current->right = right_rotate_avl(right);
+    *link = left_rotate_avl(current);
+    current->balance = (pivot->balance < 0) ? 1 : 0;
+    right->balance = (pivot->balance > 0) ? -1 : 0;
+    pivot->balance = 0;
+    return 1;
+}
+
+AVLNode *insert_avl(AVLNode *node, int data)
+{
+    AVLNode *new_node = new_avl_node(data, 0, NULL, NULL);
+    if (new_node == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to insert into AVL tree: allocation failure.\n"
+        );
+        return NULL;
+    }
+    insert_avl_node(&node, new_node);
+    return node;
+}
+
+void insert_avl_node(AVLNode **root_ref, AVLNode *node)
+{
+    AVLNode **path[CDSA_AVL_TREE_MAX_HEIGHT];
+    unsigned char went_right[CDSA_AVL_TREE_MAX_HEIGHT];
+    AVLNode **link = root_ref;
+    AVLNode *current;
+    int depth = 0;
+    node->balance = 0;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    node->size = 1;
+#endif
+    node->left = NULL;
+    node->right = NULL;
+    while (*link)
+    {
+        path[depth] = link;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+        (*link)->size += 1;
+#endif
+        if (node->data < (*link)->data)
+        {
+            went_right[depth++] = 0;
+            link = &(*link)->left;
+        }
+        else
+        {
+            went_right[depth++] = 1;
+            link = &(*link)->right;
+        }
+    }
+    *link = node;
+    /* Each ancestor's subtree grew on one side; stop once its height holds */
+    while (depth > 0)
+    {
+        link = path[--depth];
+        current = *link;
+        if (!went_right[depth])
+        {
+            if (current->balance < 0)
+            {
+                current->balance = 0;
+                break;
+            }
+            if (current->balance == 0)
+            {
+                current->balance = 1;
+                continue;
+            }
+            avl_fix_left_heavy(link);
+            break;
+        }
+        if (current->balance > 0)
+        {
+            current->balance = 0;
+            break;
+        }
+        if (current->balance == 0)
+        {
+            current->balance = -1;
+            continue;
+        }
+        avl_fix_right_heavy(link);
+        break;
+    }
+}
+
+static int build_avl_from_sorted_range(
+    const int *arr,
+    int n,
+    int *height_ref,
+    AVLNode **node_ref
+)
+{
+    int middle = n / 2;
+    int left_height, right_height;
+    AVLNode *node;
+    *node_ref = NULL;
+    *height_ref = 0;
+    if (n == 0) return 1;
+    node = new_avl_node(arr[middle], 0, NULL, NULL);
+    if (node == NULL) return 0;
+    if (!build_avl_from_sorted_range(arr, middle, &left_height, &node->left)
+        || !build_avl_from_sorted_range(
+            arr + middle + 1,
+            n - middle - 1,
+            &right_height,
+            &node->right
+        ))
+    {
+        destroy_avl(node);
+        return 0;
+    }
+    /* The left range is never smaller, so the balance is either 0 or 1 */
+    node->balance = left_height - right_height;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    node->size = n;
+#endif
+    *height_ref = left_height + 1;
+    *node_ref = node;
+    return 1;
+}
+
+AVLNode *build_avl_from_sorted(const int *arr, int n)
+{
+    AVLNode *root;
+    int i, height;
+    if (n < 0 || (arr == NULL && n > 0))
+    {
+        fprintf(stderr, "Failed to build AVL tree: invalid array.\n");
+        return NULL;
+    }
+    for (i = 1; i < n; i += 1)
+    {
+        if (arr[i - 1] > arr[i])
+        {
+            fprintf(stderr, "Failed to build AVL tree: array is not sorted.\n");
+            return NULL;
+        }
+    }
+    if (!build_avl_from_sorted_range(arr, n, &height, &root))
+    {
+        fprintf(
+            stderr,
+            "Failed to build AVL tree: allocation failure.\n"
+        );
+        return NULL;
+    }
+    return root;
+}
+
+AVLNode *search_avl(AVLNode *node, int data)
+{
+    while (node && node->data != data)
+    {
+        node = (data < node->data) ? node->left : node->right;
+    }
+    return node;
+}
+
+int delete_avl(AVLNode **root_ref, int data)
+{
+    AVLNode **path[CDSA_AVL_TREE_MAX_HEIGHT];
+    unsigned char went_right[CDSA_AVL_TREE_MAX_HEIGHT];
+    AVLNode **link;
+    AVLNode *target, *current;
+    int depth = 0;
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    int i;
+#endif
+    if (root_ref == NULL)
+    {
+        return CDSA_AVL_TREE_NULL;
+    }
+    link = root_ref;
+    while (*link && (*link)->data != data)
+    {
+        path[depth] = link;
+        if (data < (*link)->data)
+        {
+            went_right[depth++] = 0;
+            link = &(*link)->left;
+        }
+        else
+        {
+            went_right[depth++] = 1;
+            link = &(*link)->right;
+        }
+    }
+    target = *link;
+    if (target == NULL)
+    {
+        return CDSA_AVL_TREE_NOT_FOUND;
+    }
+    if (target->left && target->right)
+    {
+        /* Take the in-order successor's data and unlink that node instead */
+        path[depth] = link;
+        went_right[depth++] = 1;
+        link = &target->right;
+        while ((*link)->left)
+        {
+            path[depth] = link;
+            went_right[depth++] = 0;
+            link = &(*link)->left;
+        }
+        target->data = (*link)->data;
+        target = *link;
+    }
+    *link = target->left ? target->left : target->right;
+    free(target);
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+    for (i = 0; i < depth; i += 1)
+    {
+        (*path[i])->size -= 1;
+    }
+#endif
+    /* Each ancestor's subtree shrank on one side; stop once its height holds */
+    while (depth > 0)
+    {
+        link = path[--depth];
+        current = *link;
+        if (!went_right[depth])
+        {
+            if (current->balance > 0)
+            {
+                current->balance = 0;
+                continue;
+            }
+            if (current->balance == 0)
+            {
+                current->balance = -1;
+                break;
+            }
+            if (!avl_fix_right_heavy(link)) break;
+            continue;
+        }
+        if (current->balance < 0)
+        {
+            current->balance = 0;
+            continue;
+        }
+        if (current->balance == 0)
+        {
+            current->balance = 1;
+            break;
+        }
+        if (!avl_fix_left_heavy(link)) break;
+    }
+    return CDSA_AVL_TREE_OK;
+}
+
+#if defined(CDSA_AVL_TREE_ORDER_STATISTICS)
+int select_kth_avl(AVLNode *root, int k, int *data_ref)
+{
+    int left_size;
+    if (data_ref == NULL)
+    {
+        return CDSA_AVL_TREE_NULL;
+    }
+    if (k < 0 || k >= avl_size(root))
+    {
+        return CDSA_AVL_TREE_NOT_FOUND;
+    }
+    while (1)
+    {
+        left_size = avl_size(root->left);
+        if (k == left_size) break;
+        if (k < left_size)
+        {
+            root = root->left;
+        }
+        else
+        {
+            k -= left_size + 1;
+            root = root->right;
+        }
+    }
+    *data_ref = root->data;
+    return CDSA_AVL_TREE_OK;
+}
+
+int rank_of_avl(AVLNode *root, int data, int *rank_ref)
+{
+    int rank = 0;
+    if (rank_ref == NULL)
+    {
+        return CDSA_AVL_TREE_NULL;
+    }
+    while (root)
+    {
+        if (root->data < data)
+        {
+            rank += avl_size(root->left) + 1;
+            root = root->right;
+        }
+        else
+        {
+            root = root->left;
+        }
+    }
+    *rank_ref = rank;
+    return CDSA_AVL_TREE_OK;
+}
+#endif
+
+FrozenAVL *freeze_avl(AVLNode *root)
+{
+    AVLNode *stack[CDSA_AVL_TREE_MAX_HEIGHT];
+    AVLNode *node = root;
+    FrozenAVL *frozen;
+    int top = 0, count = 0, k = 1;
+    while (node != NULL || top > 0)
+    {
+        while (node != NULL)
+        {
+            stack[top++] = node;
+            node = node->left;
+        }
+        node = stack[--top];
+        count += 1;
+        node = node->right;
+    }
+    frozen = malloc(sizeof(FrozenAVL));
+    if (frozen == NULL)
+    {
+        fprintf(stderr, "Failed to freeze AVL tree: allocation failure.\n");
+        return NULL;
+    }
+    frozen->keys = malloc(((size_t)count + 1) * sizeof(int));
+    if (frozen->keys == NULL)
+    {
+        fprintf(stderr, "Failed to freeze AVL tree: allocation failure.\n");
+        free(frozen);
+        return NULL;
+    }
+    frozen->count = count;
+    /* Walk the tree in order again, placing each key at the in-order
+     * successor of the previous Eytzinger slot */
+    while (k <= count / 2) k *= 2;
+    node = root;
+    while (node != NULL || top > 0)
+    {
+        while (node != NULL)
+        {
+            stack[top++] = node;
+            node = node->left;
+        }
+        node = stack[--top];
+        frozen->keys[k] = node->data;
+        if (k <= (count - 1) / 2)
+        {
+            k = 2 * k + 1;
+            while (k <= count / 2) k *= 2;
+        }
+        else
+        {
+            while (k & 1) k >>= 1;
+            k >>= 1;
+        }
+        node = node->right;
+    }
+    return frozen;
+}
+
+int search_frozen_avl(const FrozenAVL *frozen, int data)
+{
+    const int *keys;
+    size_t k = 1, count;
+    if (frozen == NULL)
+    {
+        fprintf(stderr, "Failed to search frozen AVL tree: pointer is NULL.\n");
+        return CDSA_AVL_TREE_NULL;
+    }
+    keys = frozen->keys;
+    count = (size_t)frozen->count;
+    while (k <= count)
+    {
+        /* keys[16k..16k + 15] are the descendants four levels down */
+        CDSA_AVL_TREE_PREFETCH(keys + (16 * k <= count ? 16 * k : 0));
+        k = 2 * k + (size_t)(keys[k] < data);
+    }
+    /* Undo the right turns after the last left turn (the lower bound) */
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    return (k != 0 && keys[k] == data)
+        ? CDSA_AVL_TREE_OK : CDSA_AVL_TREE_NOT_FOUND;
+}
+
+void destroy_frozen_avl(FrozenAVL *frozen)
+{
+    if (frozen == NULL) return;
+    free(frozen->keys);
+    free(frozen);
+}
+
+int seek_avl_iterator(
+    AVLNode *root,
+    int lo,
+    int hi,
+    AVLIterator *iterator
+)
+{
+    const AVLNode *node;
+    if (iterator == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to seek AVL tree iterator: pointer is NULL.\n"
+        );
+        return CDSA_AVL_TREE_NULL;
+    }
+    iterator->top = 0;
+    iterator->lo = lo;
+    iterator->hi = hi;
+    node = root;
+    while (node != NULL)
+    {
+        if (node->data < lo)
+        {
+            node = node->right;
+            continue;
+        }
+        if (node->data <= hi)
+        {
+            iterator->stack[iterator->top++] = node;
+        }
+        node = node->left;
+    }
+    return CDSA_AVL_TREE_OK;
+}
+
+int next_avl_iterator(
+    AVLIterator *iterator,
+    int *out,
+    int capacity,
+    int *count_ref
+)
+{
+    const AVLNode *node;
+    int count = 0;
+    if (iterator == NULL || count_ref == NULL || (out == NULL && capacity > 0))
+    {
+        fprintf(
+            stderr,
+            "Failed to advance AVL tree iterator: pointer is NULL.\n"
+        );
+        return CDSA_AVL_TREE_NULL;
+    }
+    while (count < capacity && iterator->top > 0)
+    {
+        node = iterator->stack[--iterator->top];
+        out[count++] = node->data;
+        /* The right subtree is not below node->data, so only keys above hi
+         * are skipped there */
+        for (node = node->right; node != NULL; node = node->left)
+        {
+            if (node->data > iterator->hi) continue;
+            iterator->stack[iterator->top++] = node;
+        }
+    }
+    *count_ref = count;
+    return CDSA_AVL_TREE_OK;
+}
+
+int range_avl(
+    AVLNode *root,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+)
+{
+    AVLIterator iterator;
+    int rc;
+    if (count_ref == NULL)
+    {
+        fprintf(stderr, "Failed to query AVL tree range: pointer is NULL.\n");
+        return CDSA_AVL_TREE_NULL;
+    }
+    *count_ref = 0;
+    rc = seek_avl_iterator(root, lo, hi, &iterator);
+    if (rc != CDSA_AVL_TREE_OK) return rc;
+    return next_avl_iterator(&iterator, out, capacity, count_ref);
+}
+
+void destroy_avl(AVLNode *node)
+{
+    AVLNode *next;
+    /* Rotate right until the node has no left child, then free it and go
+     * on with its right child, in O(1) extra memory. */
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            next = node->left;
+            node->left = next->right;
+            next->right = node;
+        }
+        else
+        {
+            next = node->right;
+            free(node);
+        }
+        node = next;
+    }
+}
+
+void print_avl_sideways(const AVLNode *node, int depth)
+{
+    int i;
+    if (node == NULL) return;
+    print_avl_sideways(node->right, depth + 1);
+    for (i = 0; i < depth; i++) printf("    ");
+    printf("%d\n", node->data);
+    print_avl_sideways(node->left, depth + 1);
+}
@@ -0,0 +1,818 @@
+/**
+ * @file b_plus_tree.c
+ * @author HN Thap
+ * @brief Implementation of B+ tree with cache-line sized nodes, linked leaves
+ * for range scans and vectorized key search inside nodes.
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "b_plus_tree.h"
+
+/*
+ * Vectorized key search. SSE2 is part of the x86-64 baseline and NEON is part
+ * of the AArch64 baseline, so both are picked at compile time. Define
+ * CDSA_BPLUS_TREE_NO_SIMD to only use the scalar (but still branchless) loop.
+ */
+#if !defined(CDSA_BPLUS_TREE_NO_SIMD) && defined(__SSE2__)
+#define CDSA_BPLUS_TREE_SSE2_SIMD
+#include <emmintrin.h>
+#elif !defined(CDSA_BPLUS_TREE_NO_SIMD) && defined(__ARM_NEON) \
+    && defined(__aarch64__)
+#define CDSA_BPLUS_TREE_NEON_SIMD
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief Minimum number of keys in any node except the root.
+ */
+#define CDSA_BPLUS_TREE_MIN_KEYS (CDSA_BPLUS_TREE_NODE_KEYS / 2)
+
+/**
+ * @brief Upper bound of the height of any B+ tree with up to INT_MAX keys,
+ * used to size the descent path (non-root nodes have at least 9 children).
+ */
+#define CDSA_BPLUS_TREE_MAX_HEIGHT (16)
+
+/*
+ * Count the keys less than data among the first count slots of a node. All
+ * CDSA_BPLUS_TREE_NODE_KEYS slots are read, so unused ones must be
+ * initialized (nodes are allocated zeroed).
+ */
+static int bplus_tree_rank(const int *keys, int count, int data)
+{
+#if defined(CDSA_BPLUS_TREE_SSE2_SIMD)
+    __m128i x = _mm_set1_epi32(data);
+    __m128i lt0, lt1, lt2, lt3;
+    unsigned int mask;
+    lt0 = _mm_cmplt_epi32(_mm_loadu_si128((const void *)(keys + 0)), x);
+    lt1 = _mm_cmplt_epi32(_mm_loadu_si128((const void *)(keys + 4)), x);
+    lt2 = _mm_cmplt_epi32(_mm_loadu_si128((const void *)(keys + 8)), x);
+    lt3 = _mm_cmplt_epi32(_mm_loadu_si128((const void *)(keys + 12)), x);
+    mask = (unsigned int)_mm_movemask_epi8(
+        _mm_packs_epi16(_mm_packs_epi32(lt0, lt1), _mm_packs_epi32(lt2, lt3))
+    );
+    mask &= (1u << count) - 1u;
+    return __builtin_popcount(mask);
+#elif defined(CDSA_BPLUS_TREE_NEON_SIMD)
+    static const int lanes[CDSA_BPLUS_TREE_NODE_KEYS] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int32x4_t x = vdupq_n_s32(data);
+    int32x4_t valid = vdupq_n_s32(count);
+    uint32x4_t total = vdupq_n_u32(0);
+    uint32x4_t lt;
+    int i;
+    for (i = 0; i < CDSA_BPLUS_TREE_NODE_KEYS; i += 4)
+    {
+        lt = vandq_u32(
+            vcltq_s32(vld1q_s32(keys + i), x),
+            vcltq_s32(vld1q_s32(lanes + i), valid)
+        );
+        total = vsubq_u32(total, lt); /* All-ones lanes count as one */
+    }
+    return (int)vaddvq_u32(total);
+#else
+    int i, rank = 0;
+    for (i = 0; i < count; i += 1)
+    {
+        rank += (keys[i] < data);
+    }
+    return rank;
+#endif
+}
+
+/* Count the keys not greater than data among the first count slots. */
+static int bplus_tree_rank_upper(const int *keys, int count, int data)
+{
+    return (data == INT_MAX) ? count : bplus_tree_rank(keys, count, data + 1);
+}
+
+/* Nodes are zeroed, from calloc() or from the zeroed arenas, since the
+ * vectorized rank reads unused key slots too. */
+static BPlusLeaf *bplus_tree_new_leaf(BPlusTree *tree)
+{
+    if (tree->leaves == NULL) return calloc(1, sizeof(BPlusLeaf));
+    if (tree->leaf_count == tree->leaf_capacity) return NULL;
+    return &tree->leaves[tree->leaf_count++];
+}
+
+static BPlusInner *bplus_tree_new_inner(BPlusTree *tree)
+{
+    if (tree->inners == NULL) return calloc(1, sizeof(BPlusInner));
+    if (tree->inner_count == tree->inner_capacity) return NULL;
+    return &tree->inners[tree->inner_count++];
+}
+
+/* Arena nodes are left in place until clear_bplus_tree(). */
+static void bplus_tree_free_node(const BPlusTree *tree, void *node)
+{
+    if (tree->leaves == NULL) free(node);
+}
+
+/*
+ * Find the leaf where the first key not less than data would be, recording
+ * the inner nodes and child slots along the way (path may be NULL).
+ */
+static BPlusLeaf *bplus_tree_find_leaf(
+    const BPlusTree *tree,
+    int data,
+    BPlusInner **path,
+    int *slots
+)
+{
+    void *node = tree->root;
+    BPlusInner *inner;
+    int level, slot;
+    for (level = 0; level < tree->height - 1; level += 1)
+    {
+        inner = node;
+        slot = bplus_tree_rank(inner->keys, inner->count, data);
+        if (path != NULL)
+        {
+            path[level] = inner;
+            slots[level] = slot;
+        }
+        node = inner->children[slot];
+    }
+    return node;
+}
+
+/* Remove keys[index] and children[index + 1] from an inner node. */
+static void bplus_tree_remove_entry(BPlusInner *inner, int index)
+{
+    memmove(
+        inner->keys + index,
+        inner->keys + index + 1,
+        (size_t)(inner->count - index - 1) * sizeof(int)
+    );
+    memmove(
+        inner->children + index + 1,
+        inner->children + index + 2,
+        (size_t)(inner->count - index - 1) * sizeof(void *)
+    );
+    inner->count -= 1;
+}
+
+/* Refill an underflowing leaf from a sibling, or merge it into one. */
+static void bplus_tree_fix_leaf(
+    BPlusTree *tree,
+    BPlusInner *parent,
+    int slot
+)
+{
+    BPlusLeaf *leaf = parent->children[slot];
+    BPlusLeaf *left, *right;
+    if (slot > 0)
+    {
+        left = parent->children[slot - 1];
+        if (left->count > CDSA_BPLUS_TREE_MIN_KEYS)
+        {
+            memmove(
+                leaf->keys + 1,
+                leaf->keys,
+                (size_t)leaf->count * sizeof(int)
+            );
+            leaf->keys[0] = left->keys[--left->count];
+            leaf->count += 1;
+            parent->keys[slot - 1] = leaf->keys[0];
+            return;
+        }
+    }
+    if (slot < parent->count)
+    {
+        right = parent->children[slot + 1];
+        if (right->count > CDSA_BPLUS_TREE_MIN_KEYS)
+        {
+            leaf->keys[leaf->count++] = right->keys[0];
+            right->count -= 1;
+            memmove(
+                right->keys,
+                right->keys + 1,
+                (size_t)right->count * sizeof(int)
+            );
+            parent->keys[slot] = right->keys[0];
+            return;
+        }
+    }
+    /* Both siblings are at the minimum: merge the right one of the pair
+     * into the left one */
+    if (slot > 0)
+    {
+        left = parent->children[slot - 1];
+        right = leaf;
+        slot -= 1;
+    }
+    else
+    {
+        left = leaf;
+        right = parent->children[slot + 1];
+    }
+    memcpy(
+        left->keys + left->count,
+        right->keys,
+        (size_t)right->count * sizeof(int)
+    );
+    left->count += right->count;
+    left->next = right->next;
+    bplus_tree_free_node(tree, right);
+    bplus_tree_remove_entry(parent, slot);
+}
+
+/* Refill an underflowing inner node from a sibling, or merge it into one. */
+static void bplus_tree_fix_inner(
+    BPlusTree *tree,
+    BPlusInner *parent,
+    int slot
+)
+{
+    BPlusInner *inner = parent->children[slot];
+    BPlusInner *left, *right;
+    if (slot > 0)
+    {
+        left = parent->children[slot - 1];
+        if (left->count > CDSA_BPLUS_TREE_MIN_KEYS)
+        {
+            memmove(
+                inner->keys + 1,
+                inner->keys,
+                (size_t)inner->count * sizeof(int)
+            );
+            memmove(
+                inner->children + 1,
+                inner->children,
+                (size_t)(inner->count + 1) * sizeof(void *)
+            );
+            inner->keys[0] = parent->keys[slot - 1];
+            inner->children[0] = left->children[left->count];
+            inner->count += 1;
+            parent->keys[slot - 1] = left->keys[left->count - 1];
+            left->count -= 1;
+            return;
+        }
+    }
+    if (slot < parent->count)
+    {
+        right = parent->children[slot + 1];
+        if (right->count > CDSA_BPLUS_TREE_MIN_KEYS)
+        {
+            inner->keys[inner->count] = parent->keys[slot];
+            inner->children[inner->count + 1] = right->children[0];
+            inner->count += 1;
+            parent->keys[slot] = right->keys[0];
+            memmove(
+                right->keys,
+                right->keys + 1,
+                (size_t)(right->count - 1) * sizeof(int)
+            );
+            memmove(
+                right->children,
+                right->children + 1,
+                (size_t)right->count * sizeof(void *)
+            );
+            right->count -= 1;
+            return;
+        }
+    }
+    /* Both siblings are at the minimum: pull the separator down and merge
+     * the right one of the pair into the left one */
+    if (slot > 0)
+    {
+        left = parent->children[slot - 1];
+        right = inner;
+        slot -= 1;
+    }
+    else
+    {
+        left = inner;
+        right = parent->children[slot + 1];
+    }
+    left->keys[left->count] = parent->keys[slot];
+    memcpy(
+        left->keys + left->count + 1,
+        right->keys,
+        (size_t)right->count * sizeof(int)
+    );
+    memcpy(
+        left->children + left->count + 1,
+        right->children,
+        (size_t)(right->count + 1) * sizeof(void *)
+    );
+    left->count += right->count + 1;
+    bplus_tree_free_node(tree, right);
+    bplus_tree_remove_entry(parent, slot);
+}
+
+BPlusTree *new_bplus_tree()
+{
+    BPlusTree *tree = malloc(sizeof(BPlusTree));
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to create new B+ tree: failed to allocate.\n");
+        return NULL;
+    }
+    tree->root = NULL;
+    tree->height = 0;
+    tree->count = 0;
+    tree->leaves = NULL;
+    tree->leaf_count = 0;
+    tree->leaf_capacity = 0;
+    tree->inners = NULL;
+    tree->inner_count = 0;
+    tree->inner_capacity = 0;
+    return tree;
+}
+
+BPlusTree *new_bplus_tree_with_arena(int capacity)
+{
+    BPlusTree *tree;
+    if (capacity < 0)
+    {
+        fprintf(
+            stderr,
+            "Failed to create new B+ tree: capacity cannot be negative.\n"
+        );
+        return NULL;
+    }
+    tree = new_bplus_tree();
+    if (tree == NULL) return NULL;
+    /*
+     * Every leaf but the first holds at least half a node of keys, and every
+     * inner node but the root has at least 9 children, which bounds both
+     * arenas.
+     */
+    tree->leaf_capacity = capacity / (CDSA_BPLUS_TREE_NODE_KEYS / 2) + 2;
+    tree->inner_capacity = tree->leaf_capacity / 8
+        + CDSA_BPLUS_TREE_MAX_HEIGHT;
+    tree->leaves = calloc((size_t)tree->leaf_capacity, sizeof(BPlusLeaf));
+    tree->inners = calloc((size_t)tree->inner_capacity, sizeof(BPlusInner));
+    if (tree->leaves == NULL || tree->inners == NULL)
+    {
+        fprintf(stderr, "Failed to create new B+ tree: failed to allocate.\n");
+        free(tree->leaves);
+        free(tree->inners);
+        free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+int push_bplus_tree(BPlusTree *tree, int data)
+{
+    BPlusInner *path[CDSA_BPLUS_TREE_MAX_HEIGHT];
+    int slots[CDSA_BPLUS_TREE_MAX_HEIGHT];
+    /* One spare node per split, plus a new root and the new leaf */
+    void *spares[CDSA_BPLUS_TREE_MAX_HEIGHT + 1];
+    int keys[CDSA_BPLUS_TREE_NODE_KEYS + 1];
+    void *children[CDSA_BPLUS_TREE_NODE_KEYS + 2];
+    void *node;
+    BPlusLeaf *leaf, *right_leaf;
+    BPlusInner *inner, *right_inner;
+    int level, slot, splits, spare_count, separator, i;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to push to B+ tree: tree pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (tree->root == NULL)
+    {
+        tree->root = bplus_tree_new_leaf(tree);
+        if (tree->root == NULL) goto cleanup_alloc_failed;
+        tree->height = 1;
+    }
+    /* Descend by upper bound, so equal keys are appended after existing
+     * ones */
+    node = tree->root;
+    for (level = 0; level < tree->height - 1; level += 1)
+    {
+        inner = node;
+        slot = bplus_tree_rank_upper(inner->keys, inner->count, data);
+        path[level] = inner;
+        slots[level] = slot;
+        node = inner->children[slot];
+    }
+    leaf = node;
+    slot = bplus_tree_rank_upper(leaf->keys, leaf->count, data);
+    if (leaf->count < CDSA_BPLUS_TREE_NODE_KEYS)
+    {
+        memmove(
+            leaf->keys + slot + 1,
+            leaf->keys + slot,
+            (size_t)(leaf->count - slot) * sizeof(int)
+        );
+        leaf->keys[slot] = data;
+        leaf->count += 1;
+        tree->count += 1;
+        return CDSA_BPLUS_TREE_OK;
+    }
+    /* Allocate every node the split cascade needs before touching the
+     * tree, so a failure leaves it unchanged */
+    splits = 0;
+    while (splits < level
+           && path[level - 1 - splits]->count == CDSA_BPLUS_TREE_NODE_KEYS)
+    {
+        splits += 1;
+    }
+    spare_count = 0;
+    spares[spare_count] = bplus_tree_new_leaf(tree);
+    if (spares[spare_count++] == NULL) goto cleanup_spares;
+    for (i = 0; i < splits + (splits == level); i += 1)
+    {
+        spares[spare_count] = bplus_tree_new_inner(tree);
+        if (spares[spare_count++] == NULL) goto cleanup_spares;
+    }
+    /* Split the leaf: the left half keeps one more key */
+    memcpy(keys, leaf->keys, (size_t)slot * sizeof(int));
+    keys[slot] = data;
+    memcpy(
+        keys + slot + 1,
+        leaf->keys + slot,
+        (size_t)(CDSA_BPLUS_TREE_NODE_KEYS - slot) * sizeof(int)
+    );
+    right_leaf = spares[0];
+    leaf->count = (CDSA_BPLUS_TREE_NODE_KEYS + 2) / 2;
+    right_leaf->count = CDSA_BPLUS_TREE_NODE_KEYS + 1 - leaf->count;
+    memcpy(leaf->keys, keys, (size_t)leaf->count * sizeof(int));
+    memcpy(
+        right_leaf->keys,
+        keys + leaf->count,
+        (size_t)right_leaf->count * sizeof(int)
+    );
+    right_leaf->next = leaf->next;
+    leaf->next = right_leaf;
+    separator = right_leaf->keys[0];
+    node = right_leaf;
+    spare_count = 1;
+    /* Insert the separator upwards, splitting full inner nodes */
+    while (node != NULL && level > 0)
+    {
+        level -= 1;
+        inner = path[level];
+        slot = slots[level];
+        if (inner->count < CDSA_BPLUS_TREE_NODE_KEYS)
+        {
+            memmove(
+                inner->keys + slot + 1,
+                inner->keys + slot,
+                (size_t)(inner->count - slot) * sizeof(int)
+            );
+            memmove(
+                inner->children + slot + 2,
+                inner->children + slot + 1,
+                (size_t)(inner->count - slot) * sizeof(void *)
+            );
+            inner->keys[slot] = separator;
+            inner->children[slot + 1] = node;
+            inner->count += 1;
+            node = NULL;
+            break;
+        }
+        memcpy(keys, inner->keys, (size_t)slot * sizeof(int));
+        keys[slot] = separator;
+        memcpy(
+            keys + slot + 1,
+            inner->keys + slot,
+            (size_t)(CDSA_BPLUS_TREE_NODE_KEYS - slot) * sizeof(int)
+        );
+        memcpy(children, inner->children, (size_t)(slot + 1) * sizeof(void *));
+        children[slot + 1] = node;
+        memcpy(
+            children + slot + 2,
+            inner->children + slot + 1,
+            (size_t)(CDSA_BPLUS_TREE_NODE_KEYS - slot) * sizeof(void *)
+        );
+        /* The middle key moves up instead of staying in either half */
+        right_inner = spares[spare_count++];
+        inner->count = CDSA_BPLUS_TREE_NODE_KEYS / 2;
+        right_inner->count = CDSA_BPLUS_TREE_NODE_KEYS - inner->count;
+        memcpy(inner->keys, keys, (size_t)inner->count * sizeof(int));
+        memcpy(
+            inner->children,
+            children,
+            (size_t)(inner->count + 1) * sizeof(void *)
+        );
+        separator = keys[inner->count];
+        memcpy(
+            right_inner->keys,
+            keys + inner->count + 1,
+            (size_t)right_inner->count * sizeof(int)
+        );
+        memcpy(
+            right_inner->children,
+            children + inner->count + 1,
+            (size_t)(right_inner->count + 1) * sizeof(void *)
+        );
+        node = right_inner;
+    }
+    if (node != NULL)
+    {
+        inner = spares[spare_count];
+        inner->keys[0] = separator;
+        inner->children[0] = tree->root;
+        inner->children[1] = node;
+        inner->count = 1;
+        tree->root = inner;
+        tree->height += 1;
+    }
+    tree->count += 1;
+    return CDSA_BPLUS_TREE_OK;
+cleanup_spares:
+    for (i = 0; i < spare_count; i += 1)
+    {
+        bplus_tree_free_node(tree, spares[i]);
+    }
+    /* The last spare failed, and the others are on top of the arenas */
+    if (tree->leaves != NULL && spare_count > 1)
+    {
+        tree->leaf_count -= 1;
+        tree->inner_count -= spare_count - 2;
+    }
+cleanup_alloc_failed:
+    fprintf(stderr, "Failed to push to B+ tree: failed to allocate memory.\n");
+    return CDSA_BPLUS_TREE_ALLOC_FAILED;
+}
+
+int pop_bplus_tree(BPlusTree *tree, int data)
+{
+    BPlusInner *path[CDSA_BPLUS_TREE_MAX_HEIGHT];
+    int slots[CDSA_BPLUS_TREE_MAX_HEIGHT];
+    BPlusLeaf *leaf;
+    BPlusInner *inner;
+    void *node;
+    int level, depth, slot;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to pop from B+ tree: tree pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (tree->root == NULL) return CDSA_BPLUS_TREE_NOT_FOUND;
+    depth = tree->height - 1;
+    leaf = bplus_tree_find_leaf(tree, data, path, slots);
+    slot = bplus_tree_rank(leaf->keys, leaf->count, data);
+    if (slot == leaf->count)
+    {
+        /* Equal keys may start in the next leaf, under another parent:
+         * move the path to that leaf */
+        if (leaf->next == NULL || leaf->next->keys[0] != data)
+        {
+            return CDSA_BPLUS_TREE_NOT_FOUND;
+        }
+        level = depth - 1;
+        while (slots[level] == path[level]->count) level -= 1;
+        slots[level] += 1;
+        node = path[level]->children[slots[level]];
+        for (level += 1; level < depth; level += 1)
+        {
+            path[level] = node;
+            slots[level] = 0;
+            node = path[level]->children[0];
+        }
+        leaf = node;
+        slot = 0;
+    }
+    else if (leaf->keys[slot] != data)
+    {
+        return CDSA_BPLUS_TREE_NOT_FOUND;
+    }
+    leaf->count -= 1;
+    memmove(
+        leaf->keys + slot,
+        leaf->keys + slot + 1,
+        (size_t)(leaf->count - slot) * sizeof(int)
+    );
+    tree->count -= 1;
+    if (depth == 0)
+    {
+        if (leaf->count == 0)
+        {
+            bplus_tree_free_node(tree, leaf);
+            tree->root = NULL;
+            tree->height = 0;
+        }
+        return CDSA_BPLUS_TREE_OK;
+    }
+    if (leaf->count >= CDSA_BPLUS_TREE_MIN_KEYS) return CDSA_BPLUS_TREE_OK;
+    bplus_tree_fix_leaf(tree, path[depth - 1], slots[depth - 1]);
+    /* A merge removes one key from the parent, which may underflow too */
+    for (level = depth - 1; level > 0; level -= 1)
+    {
+        if (path[level]->count >= CDSA_BPLUS_TREE_MIN_KEYS) break;
+        bplus_tree_fix_inner(tree, path[level - 1], slots[level - 1]);
+    }
+    inner = tree->root;
+    if (inner->count == 0)
+    {
+        tree->root = inner->children[0];
+        tree->height -= 1;
+        bplus_tree_free_node(tree, inner);
+    }
+    return CDSA_BPLUS_TREE_OK;
+}
+
+int search_bplus_tree(const BPlusTree *tree, int data)
+{
+    const BPlusLeaf *leaf;
+    int slot;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to search B+ tree: tree pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (tree->root == NULL) return CDSA_BPLUS_TREE_NOT_FOUND;
+    leaf = bplus_tree_find_leaf(tree, data, NULL, NULL);
+    slot = bplus_tree_rank(leaf->keys, leaf->count, data);
+    if (slot == leaf->count)
+    {
+        leaf = leaf->next;
+        slot = 0;
+    }
+    return (leaf != NULL && leaf->keys[slot] == data)
+        ? CDSA_BPLUS_TREE_OK : CDSA_BPLUS_TREE_NOT_FOUND;
+}
+
+int begin_bplus_tree_iterator(
+    const BPlusTree *tree,
+    BPlusTreeIterator *iterator
+)
+{
+    if (tree == NULL || iterator == NULL)
+    {
+        fprintf(stderr, "Failed to begin B+ tree iterator: pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    iterator->leaf = (tree->root == NULL)
+        ? NULL : bplus_tree_find_leaf(tree, INT_MIN, NULL, NULL);
+    iterator->index = 0;
+    return CDSA_BPLUS_TREE_OK;
+}
+
+int seek_bplus_tree_iterator(
+    const BPlusTree *tree,
+    int data,
+    BPlusTreeIterator *iterator
+)
+{
+    if (tree == NULL || iterator == NULL)
+    {
+        fprintf(stderr, "Failed to seek B+ tree iterator: pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    iterator->leaf = NULL;
+    iterator->index = 0;
+    if (tree->root == NULL) return CDSA_BPLUS_TREE_OK;
+    iterator->leaf = bplus_tree_find_leaf(tree, data, NULL, NULL);
+    iterator->index = bplus_tree_rank(
+        iterator->leaf->keys,
+        iterator->leaf->count,
+        data
+    );
+    return CDSA_BPLUS_TREE_OK;
+}
+
+int next_bplus_tree_iterator(BPlusTreeIterator *iterator, int *data_ref)
+{
+    if (iterator == NULL || data_ref == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to advance B+ tree iterator: pointer is NULL.\n"
+        );
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    while (iterator->leaf != NULL && iterator->index >= iterator->leaf->count)
+    {
+        iterator->leaf = iterator->leaf->next;
+        iterator->index = 0;
+    }
+    if (iterator->leaf == NULL) return CDSA_BPLUS_TREE_EMPTY;
+    *data_ref = iterator->leaf->keys[iterator->index++];
+    return CDSA_BPLUS_TREE_OK;
+}
+
+void clear_bplus_tree_recursive(void *node, int level, int height)
+{
+    BPlusInner *inner;
+    int i;
+    if (level < height - 1)
+    {
+        inner = node;
+        for (i = 0; i <= inner->count; i += 1)
+        {
+            clear_bplus_tree_recursive(inner->children[i], level + 1, height);
+        }
+    }
+    free(node);
+}
+
+int clear_bplus_tree(BPlusTree *tree)
+{
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to clear B+ tree: tree pointer is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (tree->leaves != NULL)
+    {
+        /* Taken nodes are zeroed again for their next use */
+        memset(tree->leaves, 0, (size_t)tree->leaf_count * sizeof(BPlusLeaf));
+        memset(
+            tree->inners,
+            0,
+            (size_t)tree->inner_count * sizeof(BPlusInner)
+        );
+        tree->leaf_count = 0;
+        tree->inner_count = 0;
+    }
+    else if (tree->root != NULL)
+    {
+        clear_bplus_tree_recursive(tree->root, 0, tree->height);
+    }
+    tree->root = NULL;
+    tree->height = 0;
+    tree->count = 0;
+    return CDSA_BPLUS_TREE_OK;
+}
+
+int destroy_bplus_tree(BPlusTree **tree_ref)
+{
+    if (tree_ref == NULL)
+    {
+        fprintf(stderr, "Failed to destroy B+ tree: tree reference is NULL.\n");
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (*tree_ref == NULL)
+    {
+        return CDSA_BPLUS_TREE_OK;
+    }
+    /*
+     * As per current implementation of clear_bplus_tree(),
+     * since *tree_ref could not be NULL, clear_bplus_tree() would not fail.
+     */
+    (void)clear_bplus_tree(*tree_ref);
+    free((*tree_ref)->leaves);
+    free((*tree_ref)->inners);
+    free(*tree_ref);
+    *tree_ref = NULL;
+    return CDSA_BPLUS_TREE_OK;
+}
+
+void print_bplus_tree_sideways_recursive(
+    const void *node,
+    int level,
+    int height
+)
+{
+    const BPlusLeaf *leaf;
+    const BPlusInner *inner;
+    int i, j;
+    if (level == height - 1)
+    {
+        leaf = node;
+        for (i = 0; i < level; i++) printf("    ");
+        printf("[");
+        for (i = 0; i < leaf->count; i++)
+        {
+            printf(i ? " %d" : "%d", leaf->keys[i]);
+        }
+        printf("]\n");
+        return;
+    }
+    inner = node;
+    for (i = inner->count; i >= 0; i--)
+    {
+        print_bplus_tree_sideways_recursive(
+            inner->children[i],
+            level + 1,
+            height
+        );
+        if (i > 0)
+        {
+            for (j = 0; j < level; j++) printf("    ");
+            printf("%d\n", inner->keys[i - 1]);
+        }
+    }
+}
+
+int print_bplus_tree_sideways(const BPlusTree *tree)
+{
+    if (tree == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to print B+ tree sideways: tree pointer is NULL.\n"
+        );
+        return CDSA_BPLUS_TREE_NULL;
+    }
+    if (tree->root != NULL)
+    {
+        print_bplus_tree_sideways_recursive(tree->root, 0, tree->height);
+    }
+    return CDSA_BPLUS_TREE_OK;
+}
@@ -0,0 +1,453 @@
+/**
+ * @file concurrent_bst.c
+ * @author HN Thap
+ * @brief Concurrent, unbalanced binary search tree with lock-free readers
+ * and epoch-based reclamation.
+ * 
+ * Readers take no lock and write nothing shared: a search only announces
+ * itself in the epoch word of its own ConcurrentBSTReader, which sits on a
+ * cache line of its own, so lookups scale with the number of cores instead
+ * of bouncing a lock between them.
+ * 
+ * Writers are serialized by one mutex, and change the tree so that a reader
+ * racing with them always walks a valid BST holding every key that is not
+ * being pushed or popped:
+ * - The key of a node never changes once it is published, and child links
+ *   are published with release stores (read with acquire loads).
+ * - A new key is linked as a leaf, fully initialized beforehand.
+ * - A popped node with at most one child is bypassed by a single store; its
+ *   own links are left intact for the readers still standing on it.
+ * - A popped node with two children is replaced by a copy of its successor,
+ *   together with copies of the path down to that successor, and the new
+ *   subtree is published by a single store. Readers see either the whole old
+ *   subtree or the whole new one.
+ * 
+ * Bypassed nodes are retired instead of freed. Once
+ * CDSA_CONCURRENT_BST_RETIRE_BATCH of them have piled up, the writer starts
+ * a new epoch, waits until no reader is still inside a search that began in
+ * an older epoch (a grace period), and frees them all. Searches are short,
+ * so the wait is too, and it is amortized over the whole batch.
+ * 
+ * As in simple_bst.c, the tree is not balanced: keys pushed in sorted order
+ * make it a list. Push shuffled keys, or use a frozen or AVL tree for data
+ * that rarely changes.
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+/* Needed for POSIX threads and sched_yield() under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "concurrent_bst.h"
+
+/*
+ * Memory ordering. C90 has no atomics, so this relies on the __atomic
+ * builtins of GCC and Clang.
+ */
+#if defined(__GNUC__)
+#define CDSA_CONCURRENT_BST_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define CDSA_CONCURRENT_BST_STORE(p, v) \
+    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define CDSA_CONCURRENT_BST_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#error "concurrent_bst.c needs the __atomic builtins of GCC or Clang."
+#endif
+
+/**
+ * @brief Size of a cache line. Reader epochs are kept this far apart from
+ * each other, and from the fields that writers update.
+ */
+#define CDSA_CONCURRENT_BST_CACHE_LINE (64)
+
+/**
+ * @brief Number of popped nodes retired before a grace period frees them.
+ */
+#define CDSA_CONCURRENT_BST_RETIRE_BATCH (256)
+
+typedef struct ConcurrentBSTNode
+{
+    int data;
+    struct ConcurrentBSTNode *left;
+    struct ConcurrentBSTNode *right;
+} ConcurrentBSTNode;
+
+struct ConcurrentBSTReader
+{
+    unsigned long epoch; /* Epoch of the current search, 0 outside one */
+    char padding[CDSA_CONCURRENT_BST_CACHE_LINE];
+    ConcurrentBST *set;
+    struct ConcurrentBSTReader *next; /* Next reader of the same tree */
+    int attached;
+};
+
+struct ConcurrentBST
+{
+    /* Read by every search */
+    ConcurrentBSTNode *root;
+    unsigned long epoch; /* Never 0 */
+    char padding[CDSA_CONCURRENT_BST_CACHE_LINE];
+    /* Only touched by writers, under lock */
+    pthread_mutex_t lock;
+    ConcurrentBSTReader *readers;
+    ConcurrentBSTNode *retired[CDSA_CONCURRENT_BST_RETIRE_BATCH];
+    int retired_count;
+};
+
+static ConcurrentBSTNode *new_concurrent_bst_node(
+    int data,
+    ConcurrentBSTNode *left,
+    ConcurrentBSTNode *right
+)
+{
+    ConcurrentBSTNode *node = malloc(sizeof(ConcurrentBSTNode));
+    if (node == NULL) return NULL;
+    node->data = data;
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+/* Free a whole subtree with O(1) extra memory: left children are rotated up
+ * until the node at hand has none, then it is freed and its right subtree is
+ * next. */
+static void concurrent_bst_free_nodes(ConcurrentBSTNode *node)
+{
+    ConcurrentBSTNode *left;
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else
+        {
+            left = node->right;
+            free(node);
+            node = left;
+        }
+    }
+}
+
+static void concurrent_bst_enter(ConcurrentBSTReader *reader)
+{
+    /* The acquire load pairs with the new epoch stored by a writer after
+     * its changes, and the fence orders the announcement before any read of
+     * the tree, against the fence of concurrent_bst_synchronize(). */
+    CDSA_CONCURRENT_BST_STORE(
+        &reader->epoch,
+        CDSA_CONCURRENT_BST_LOAD(&reader->set->epoch)
+    );
+    CDSA_CONCURRENT_BST_FENCE();
+}
+
+static void concurrent_bst_exit(ConcurrentBSTReader *reader)
+{
+    CDSA_CONCURRENT_BST_STORE(&reader->epoch, 0UL);
+}
+
+/* Wait until every search that may still see a retired node is over. Must
+ * be called under lock. */
+static void concurrent_bst_synchronize(ConcurrentBST *set)
+{
+    ConcurrentBSTReader *reader;
+    unsigned long epoch, seen;
+    CDSA_CONCURRENT_BST_FENCE();
+    epoch = set->epoch + 1;
+    if (epoch == 0) epoch = 1;
+    CDSA_CONCURRENT_BST_STORE(&set->epoch, epoch);
+    CDSA_CONCURRENT_BST_FENCE();
+    for (reader = set->readers; reader != NULL; reader = reader->next)
+    {
+        /* A reader in the new epoch started after the changes, and cannot
+         * reach any retired node. */
+        for (;;)
+        {
+            seen = CDSA_CONCURRENT_BST_LOAD(&reader->epoch);
+            if (seen == 0 || seen == epoch) break;
+            (void)sched_yield();
+        }
+    }
+}
+
+static void concurrent_bst_flush(ConcurrentBST *set)
+{
+    int i;
+    if (set->retired_count == 0) return;
+    concurrent_bst_synchronize(set);
+    for (i = 0; i < set->retired_count; i++)
+    {
+        free(set->retired[i]);
+    }
+    set->retired_count = 0;
+}
+
+/* Free a node unlinked from the tree once no reader can hold it anymore.
+ * Must be called under lock. */
+static void concurrent_bst_retire(ConcurrentBST *set, ConcurrentBSTNode *node)
+{
+    if (set->retired_count == CDSA_CONCURRENT_BST_RETIRE_BATCH)
+    {
+        concurrent_bst_flush(set);
+    }
+    set->retired[set->retired_count++] = node;
+}
+
+/* Replace the node with two children at *link with a copy of its successor,
+ * whose right subtree is a copy of the path from node->right down to the
+ * successor, without the successor. Must be called under lock. */
+static int concurrent_bst_pop_two_children(
+    ConcurrentBST *set,
+    ConcurrentBSTNode **link
+)
+{
+    ConcurrentBSTNode *node = *link;
+    ConcurrentBSTNode *replacement, *source, *copy, *next;
+    ConcurrentBSTNode **copy_link;
+    replacement = new_concurrent_bst_node(0, node->left, NULL);
+    if (replacement == NULL) return CDSA_CONCURRENT_BST_ALLOC_FAILED;
+    copy_link = &replacement->right;
+    for (source = node->right; source->left != NULL; source = source->left)
+    {
+        copy = new_concurrent_bst_node(source->data, NULL, source->right);
+        if (copy == NULL)
+        {
+            /* Unpublished: the copies only own their left links. */
+            for (copy = replacement->right; copy != NULL; copy = next)
+            {
+                next = copy->left;
+                free(copy);
+            }
+            free(replacement);
+            return CDSA_CONCURRENT_BST_ALLOC_FAILED;
+        }
+        *copy_link = copy;
+        copy_link = &copy->left;
+    }
+    replacement->data = source->data;
+    *copy_link = source->right;
+    CDSA_CONCURRENT_BST_STORE(link, replacement);
+    /* Retiring may free earlier nodes, never these ones: read the links
+     * before handing each node over. */
+    source = node->right;
+    concurrent_bst_retire(set, node);
+    while (source != NULL)
+    {
+        next = source->left;
+        concurrent_bst_retire(set, source);
+        source = next;
+    }
+    return CDSA_CONCURRENT_BST_OK;
+}
+
+ConcurrentBST *new_concurrent_bst()
+{
+    ConcurrentBST *set = malloc(sizeof(ConcurrentBST));
+    if (set == NULL) return NULL;
+    if (pthread_mutex_init(&set->lock, NULL) != 0)
+    {
+        free(set);
+        return NULL;
+    }
+    set->root = NULL;
+    set->epoch = 1;
+    set->readers = NULL;
+    set->retired_count = 0;
+    return set;
+}
+
+ConcurrentBSTReader *attach_concurrent_bst_reader(ConcurrentBST *set)
+{
+    ConcurrentBSTReader *reader;
+    if (set == NULL) return NULL;
+    pthread_mutex_lock(&set->lock);
+    for (reader = set->readers; reader != NULL; reader = reader->next)
+    {
+        if (!reader->attached) break;
+    }
+    if (reader == NULL)
+    {
+        reader = malloc(sizeof(ConcurrentBSTReader));
+        if (reader != NULL)
+        {
+            reader->epoch = 0;
+            reader->set = set;
+            reader->next = set->readers;
+            set->readers = reader;
+        }
+    }
+    if (reader != NULL) reader->attached = 1;
+    pthread_mutex_unlock(&set->lock);
+    return reader;
+}
+
+int detach_concurrent_bst_reader(ConcurrentBSTReader **reader_ref)
+{
+    ConcurrentBST *set;
+    if (reader_ref == NULL || *reader_ref == NULL)
+    {
+        return CDSA_CONCURRENT_BST_NULL;
+    }
+    set = (*reader_ref)->set;
+    pthread_mutex_lock(&set->lock);
+    (*reader_ref)->attached = 0;
+    pthread_mutex_unlock(&set->lock);
+    *reader_ref = NULL;
+    return CDSA_CONCURRENT_BST_OK;
+}
+
+int push_concurrent_bst(ConcurrentBST *set, int data)
+{
+    ConcurrentBSTNode **link;
+    ConcurrentBSTNode *node;
+    int rc = CDSA_CONCURRENT_BST_OK;
+    if (set == NULL) return CDSA_CONCURRENT_BST_NULL;
+    pthread_mutex_lock(&set->lock);
+    /* Writers are serialized, so plain loads see the latest tree. */
+    link = &set->root;
+    while (*link != NULL && (*link)->data != data)
+    {
+        link = data < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    if (*link != NULL)
+    {
+        rc = CDSA_CONCURRENT_BST_DUPLICATE;
+        goto cleanup_push_concurrent_bst;
+    }
+    node = new_concurrent_bst_node(data, NULL, NULL);
+    if (node == NULL)
+    {
+        rc = CDSA_CONCURRENT_BST_ALLOC_FAILED;
+        goto cleanup_push_concurrent_bst;
+    }
+    CDSA_CONCURRENT_BST_STORE(link, node);
+cleanup_push_concurrent_bst:
+    pthread_mutex_unlock(&set->lock);
+    return rc;
+}
+
+int pop_concurrent_bst(ConcurrentBST *set, int data)
+{
+    ConcurrentBSTNode **link;
+    ConcurrentBSTNode *node;
+    int rc = CDSA_CONCURRENT_BST_OK;
+    if (set == NULL) return CDSA_CONCURRENT_BST_NULL;
+    pthread_mutex_lock(&set->lock);
+    link = &set->root;
+    while (*link != NULL && (*link)->data != data)
+    {
+        link = data < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    node = *link;
+    if (node == NULL)
+    {
+        rc = CDSA_CONCURRENT_BST_NOT_FOUND;
+    }
+    else if (node->left != NULL && node->right != NULL)
+    {
+        rc = concurrent_bst_pop_two_children(set, link);
+    }
+    else
+    {
+        CDSA_CONCURRENT_BST_STORE(
+            link,
+            node->left != NULL ? node->left : node->right
+        );
+        concurrent_bst_retire(set, node);
+    }
+    pthread_mutex_unlock(&set->lock);
+    return rc;
+}
+
+int search_concurrent_bst(ConcurrentBSTReader *reader, int data)
+{
+    const ConcurrentBSTNode *node;
+    if (reader == NULL) return CDSA_CONCURRENT_BST_NULL;
+    concurrent_bst_enter(reader);
+    node = CDSA_CONCURRENT_BST_LOAD(&reader->set->root);
+    while (node != NULL && node->data != data)
+    {
+        node = data < node->data
+            ? CDSA_CONCURRENT_BST_LOAD(&node->left)
+            : CDSA_CONCURRENT_BST_LOAD(&node->right);
+    }
+    concurrent_bst_exit(reader);
+    if (node == NULL) return CDSA_CONCURRENT_BST_NOT_FOUND;
+    return CDSA_CONCURRENT_BST_OK;
+}
+
+int range_concurrent_bst(
+    ConcurrentBSTReader *reader,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+)
+{
+    const ConcurrentBSTNode *node, *ceiling;
+    int count = 0;
+    if (reader == NULL || out == NULL || count_ref == NULL)
+    {
+        return CDSA_CONCURRENT_BST_NULL;
+    }
+    concurrent_bst_enter(reader);
+    while (count < capacity && lo <= hi)
+    {
+        /* Smallest key not less than lo. A fresh descent per key, rather
+         * than an iterator stack, stays correct while the tree changes. */
+        ceiling = NULL;
+        node = CDSA_CONCURRENT_BST_LOAD(&reader->set->root);
+        while (node != NULL)
+        {
+            if (node->data >= lo)
+            {
+                ceiling = node;
+                node = CDSA_CONCURRENT_BST_LOAD(&node->left);
+            }
+            else
+            {
+                node = CDSA_CONCURRENT_BST_LOAD(&node->right);
+            }
+        }
+        if (ceiling == NULL || ceiling->data > hi) break;
+        out[count++] = ceiling->data;
+        if (ceiling->data == INT_MAX) break;
+        lo = ceiling->data + 1;
+    }
+    concurrent_bst_exit(reader);
+    *count_ref = count;
+    return CDSA_CONCURRENT_BST_OK;
+}
+
+int destroy_concurrent_bst(ConcurrentBST **set_ref)
+{
+    ConcurrentBST *set;
+    ConcurrentBSTReader *reader, *next;
+    int i;
+    if (set_ref == NULL || *set_ref == NULL) return CDSA_CONCURRENT_BST_NULL;
+    set = *set_ref;
+    concurrent_bst_free_nodes(set->root);
+    for (i = 0; i < set->retired_count; i++)
+    {
+        free(set->retired[i]);
+    }
+    for (reader = set->readers; reader != NULL; reader = next)
+    {
+        next = reader->next;
+        free(reader);
+    }
+    pthread_mutex_destroy(&set->lock);
+    free(set);
+    *set_ref = NULL;
+    return CDSA_CONCURRENT_BST_OK;
+}
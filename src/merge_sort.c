@@ -0,0 +1,2887 @@
+/**
+ * @file merge_sort.c
+ * @author HN Thap
+ * @brief Simple implementation of buffer-based merge sort algorithm.
+ * 
+ * The core function is merge_sort(), which depends on
+ * merge_sort_recursive() and merge_sort_merge().
+ * 
+ * merge_sort_bottom_up() is an iterative alternative that merges runs of
+ * doubling width, swapping the roles of the array and the buffer after each
+ * pass, so every element is moved once per pass instead of twice, and at
+ * most one final copy back into the array is needed.
+ * 
+ * Both variants insertion-sort short ranges
+ * (CDSA_MERGE_SORT_INSERTION_THRESHOLD elements or fewer) instead of
+ * splitting them further, and skip the merge when the two halves are already
+ * in order. merge_sort_natural() goes one step further and merges the
+ * natural runs of the input in powersort order, which brings the cost close
+ * to O(n) on presorted data.
+ * 
+ * All merges go through merge_sort_merge_ranges(), which dispatches at run
+ * time to a bitonic merge network (AVX-512, AVX2 or NEON) when the CPU has
+ * one, and to a branchless scalar kernel otherwise.
+ * 
+ * merge_sort_with_buffer() sorts with a scratch buffer supplied by the
+ * caller and never allocates. A MergeSortContext keeps such a buffer between
+ * calls and grows it geometrically, so repeated merge_sort_with_context()
+ * calls on batches of similar size do not touch the allocator.
+ * 
+ * merge_sort_in_place() needs no buffer at all: runs are merged by rotating
+ * blocks around split points found by binary search (O(n log^2 n) moves,
+ * O(log n) stack), with a small fixed-size stack array used when one side
+ * of a merge is short. merge_sort_with_mode() lets the caller pick between
+ * the buffered and the in-place sort in a single call.
+ * 
+ * merge_sort_parallel() spreads the same top-down recursion over a small
+ * work-stealing thread pool (POSIX threads). Each worker owns a deque of
+ * tasks and steals from the others when its own deque runs dry. The merges
+ * near the top are split by binary search into independent sub-merges, so
+ * that the final merge does not run on a single core.
+ * 
+ * merge_sort_generic() sorts elements of any size with a qsort()-style
+ * comparator, stably. For a fixed element type, the macros of
+ * include/generic_sort.h generate a merge sort with the comparison inlined
+ * instead, which keeps the speed of merge_sort().
+ * 
+ * To reorder records by an int key, merge_sort_argsort() returns the
+ * stable sorting permutation of the keys, and merge_sort_by_key() sorts the
+ * keys in-place and moves a parallel payload array of any element size
+ * along. In both, the keys stay in a packed int array next to an int array
+ * of indices, so the merges stream through ints instead of whole records,
+ * and the payload is only moved once at the end.
+ * 
+ * For data that arrives gradually, a MergeSortStream sorts each batch given
+ * to merge_sort_stream_feed() as it comes, and merges the runs of similar
+ * size right away, so that most of the work overlaps ingestion and at most
+ * 32 runs are left. After merge_sort_stream_finish(), each call to
+ * merge_sort_stream_next_sorted() pulls the next element of the k-way merge
+ * of these runs through a loser tree, with no final merge pass to wait for.
+ * 
+ * merge_sort_external() sorts binary files of native int values that do not
+ * fit in memory: it writes memory-sized sorted runs to a temporary file,
+ * then merges up to CDSA_MERGE_SORT_MAX_FAN_IN runs at a time through a
+ * loser tree. All file reads and writes are double-buffered and performed by
+ * a dedicated I/O thread, so disk I/O overlaps sorting and merging.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+/* Needed for POSIX threads under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "merge_sort.h"
+
+/*
+ * Vectorized merge kernels. On x86 with GCC-compatible compilers the AVX2 and
+ * AVX-512 kernels are compiled with per-function target attributes and picked
+ * at run time, so the binary still runs on older CPUs. NEON is part of the
+ * AArch64 baseline, so it is picked at compile time. Define
+ * CDSA_MERGE_SORT_NO_SIMD to only use the scalar branchless kernel.
+ */
+#if !defined(CDSA_MERGE_SORT_NO_SIMD) && defined(__GNUC__) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define CDSA_MERGE_SORT_X86_SIMD
+#include <immintrin.h>
+#elif !defined(CDSA_MERGE_SORT_NO_SIMD) && defined(__ARM_NEON) \
+    && defined(__aarch64__)
+#define CDSA_MERGE_SORT_NEON_SIMD
+#include <arm_neon.h>
+#endif
+
+/*
+ * Instrumentation. Define CDSA_MERGE_SORT_STATS to count, in the global
+ * merge_sort_stats, the merges done by merge_sort_merge(), the elements
+ * written by the merges and the comparisons made by the scalar kernel (the
+ * vector kernels compare whole registers and are not counted, so define
+ * CDSA_MERGE_SORT_NO_SIMD as well for exact comparison counts). The counters
+ * are not atomic, which makes them approximate under merge_sort_parallel().
+ * Otherwise, the counting macro expands to nothing.
+ */
+#if defined(CDSA_MERGE_SORT_STATS)
+MergeSortStats merge_sort_stats;
+
+#define CDSA_MERGE_SORT_COUNT(field, n) \
+    ((void)(merge_sort_stats.field += (unsigned long)(n)))
+#else
+#define CDSA_MERGE_SORT_COUNT(field, n) ((void)0)
+#endif
+
+/**
+ * @brief Ranges of at most this many elements are insertion-sorted instead
+ * of being split further. This is also the minimum run length used by
+ * merge_sort_natural().
+ */
+#define CDSA_MERGE_SORT_INSERTION_THRESHOLD (32)
+
+/**
+ * @brief Size of the stack array used by merge_sort_merge_in_place() when
+ * the shorter side of a merge fits into it.
+ */
+#define CDSA_MERGE_SORT_IN_PLACE_BUFFER (256)
+
+/**
+ * @brief Maximum number of runs merged at once by merge_sort_external().
+ * More runs are merged in several passes.
+ */
+#define CDSA_MERGE_SORT_MAX_FAN_IN (64)
+
+/**
+ * @brief Minimum number of ints merge_sort_external() keeps in memory.
+ */
+#define CDSA_MERGE_SORT_EXTERNAL_MIN_MEMORY (1024)
+
+/**
+ * @brief Number of int lanes of the widest vector merge kernel.
+ */
+#define CDSA_MERGE_SORT_SIMD_MAX_WIDTH (16)
+
+/**
+ * @brief Ranges (and merges) of at most this many elements are handled
+ * sequentially by merge_sort_parallel() instead of being split into tasks.
+ */
+#define CDSA_MERGE_SORT_PARALLEL_GRAIN (8192)
+
+/**
+ * @brief Upper bound of the number of threads used by merge_sort_parallel().
+ */
+#define CDSA_MERGE_SORT_MAX_THREADS (256)
+
+/**
+ * @brief Task kind: sort a range (see MergeSortTask).
+ */
+#define CDSA_MERGE_SORT_TASK_SORT (0)
+
+/**
+ * @brief Task kind: merge two sorted ranges (see MergeSortTask).
+ */
+#define CDSA_MERGE_SORT_TASK_MERGE (1)
+
+/**
+ * @brief Task kind: a sort task waiting for its two halves, which turns into
+ * a merge task when both are done.
+ */
+#define CDSA_MERGE_SORT_TASK_JOIN_SORT (2)
+
+/**
+ * @brief Task kind: a merge task waiting for its two sub-merges, which is
+ * done when both are done.
+ */
+#define CDSA_MERGE_SORT_TASK_JOIN_MERGE (3)
+
+/**
+ * @brief Asynchronous file read or write, served by the I/O thread of
+ * merge_sort_external().
+ * 
+ * A read seeks to *position first (if position is not NULL), reads up to
+ * count ints and stores the new position back. A write stores the current
+ * position into *position first (if not NULL), then writes count ints.
+ * When done, count is the number of ints actually transferred.
+ */
+typedef struct MergeSortIORequest
+{
+    FILE *file;
+    fpos_t *position;
+    int *data;
+    int count;
+    int is_write;
+    int done;
+    int failed;
+    struct MergeSortIORequest *next;
+} MergeSortIORequest;
+
+/**
+ * @brief I/O thread of merge_sort_external() with its request queue.
+ */
+typedef struct MergeSortIO
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t submitted;
+    pthread_cond_t completed;
+    MergeSortIORequest *head;
+    MergeSortIORequest *tail;
+    int stop;
+} MergeSortIO;
+
+/**
+ * @brief Double-buffered reader of one sorted run: while the merge consumes
+ * one block, the I/O thread fills the other.
+ */
+typedef struct MergeSortRunReader
+{
+    fpos_t position;
+    unsigned long remaining;
+    int *block[2];
+    MergeSortIORequest request[2];
+    int current;
+    int index;
+    int exhausted;
+} MergeSortRunReader;
+
+/**
+ * @brief Sorted runs stored back to back in one temporary file.
+ */
+typedef struct MergeSortRunList
+{
+    FILE *file;
+    fpos_t *position;
+    unsigned long *length;
+    int count;
+    int capacity;
+} MergeSortRunList;
+
+/**
+ * @brief A unit of work of merge_sort_parallel().
+ * 
+ * A sort task sorts src[left, right) and leaves the result in dst if to_dst
+ * is non-zero, otherwise in src. It does so by sorting both halves into the
+ * other array, then merging them back, so no copy is ever needed in between.
+ * A merge task merges a[0, a_count) and b[0, b_count) into out.
+ * 
+ * Tasks never block: a split task records its number of unfinished
+ * children in pending, and the worker finishing the last child resumes it.
+ */
+typedef struct MergeSortTask
+{
+    int kind;
+    int pending;
+    struct MergeSortTask *parent;
+    int *src;
+    int *dst;
+    int left;
+    int right;
+    int to_dst;
+    const int *a;
+    int a_count;
+    const int *b;
+    int b_count;
+    int *out;
+} MergeSortTask;
+
+/**
+ * @brief Double-ended task queue owned by one worker. The owner pushes and
+ * pops at the bottom (newest end), thieves steal from the top (oldest end),
+ * which hands them the largest pending ranges.
+ */
+typedef struct MergeSortDeque
+{
+    pthread_mutex_t lock;
+    MergeSortTask **tasks;
+    int capacity;
+    int head;
+    int count;
+} MergeSortDeque;
+
+/**
+ * @brief Work-stealing thread pool of merge_sort_parallel().
+ */
+typedef struct MergeSortPool
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    MergeSortDeque *deques;
+    int num_workers;
+    int queued;
+    int sleeping;
+    int done;
+} MergeSortPool;
+
+/**
+ * @brief Element size, comparator and scratch space of merge_sort_generic().
+ * The buffer holds the elements being merged, followed by one spare
+ * element used by the insertion sort.
+ */
+typedef struct MergeSortGeneric
+{
+    size_t size;
+    int (*compare)(const void *, const void *);
+    char *buffer;
+    char *spare;
+} MergeSortGeneric;
+
+/**
+ * @brief Argument of a worker thread.
+ */
+typedef struct MergeSortWorker
+{
+    MergeSortPool *pool;
+    int id;
+} MergeSortWorker;
+
+void merge_sort(int arr_count, int *arr)
+{
+    int *buffer;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (arr_count < 2)
+    {
+        return;
+    }
+    buffer = malloc(arr_count * sizeof(int));
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    merge_sort_recursive(arr, 0, arr_count, buffer);
+    free(buffer);
+}
+
+void merge_sort_with_buffer(int arr_count, int *arr, int *buffer)
+{
+    if (arr == NULL || buffer == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr and buffer cannot be NULL.\n");
+        return;
+    }
+    if (arr_count < 2)
+    {
+        return;
+    }
+    merge_sort_recursive(arr, 0, arr_count, buffer);
+}
+
+MergeSortContext *new_merge_sort_context()
+{
+    MergeSortContext *context = malloc(sizeof(MergeSortContext));
+    if (context == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to create new merge sort context: failed to allocate.\n"
+        );
+        return NULL;
+    }
+    context->buffer = NULL;
+    context->capacity = 0;
+    return context;
+}
+
+int merge_sort_with_context(MergeSortContext *context, int arr_count, int *arr)
+{
+    int capacity;
+    if (context == NULL || arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Merge sort failed: invalid parameter: "
+            "context and arr cannot be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_MERGE_SORT_OK;
+    if (arr_count > context->capacity)
+    {
+        /* Grow geometrically so that slowly growing batches rarely grow it. */
+        capacity = (context->capacity <= INT_MAX / 2)
+            ? 2 * context->capacity
+            : INT_MAX;
+        if (capacity < arr_count) capacity = arr_count;
+        free(context->buffer);
+        context->buffer = malloc(capacity * sizeof(int));
+        if (context->buffer == NULL)
+        {
+            context->capacity = 0;
+            fprintf(stderr, "Merge sort failed: failed to allocate buffer.\n");
+            return CDSA_MERGE_SORT_ALLOC_FAILED;
+        }
+        context->capacity = capacity;
+    }
+    merge_sort_recursive(arr, 0, arr_count, context->buffer);
+    return CDSA_MERGE_SORT_OK;
+}
+
+int destroy_merge_sort_context(MergeSortContext **context_ref)
+{
+    if (context_ref == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to destroy merge sort context: "
+            "context reference is NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (*context_ref == NULL)
+    {
+        return CDSA_MERGE_SORT_OK;
+    }
+    free((*context_ref)->buffer);
+    free(*context_ref);
+    *context_ref = NULL;
+    return CDSA_MERGE_SORT_OK;
+}
+
+void merge_sort_recursive(int *arr, int left, int right, int *buffer)
+{
+    int middle;
+    if (right - left <= CDSA_MERGE_SORT_INSERTION_THRESHOLD)
+    {
+        merge_sort_insertion(arr, left, right);
+        return;
+    }
+    middle = left + (right - left) / 2;
+    merge_sort_recursive(arr, left, middle, buffer);
+    merge_sort_recursive(arr, middle, right, buffer);
+    if (arr[middle - 1] <= arr[middle])
+    {
+        /* Both halves are already in order. */
+        return;
+    }
+    merge_sort_merge(arr, left, middle, right, buffer);
+}
+
+void merge_sort_merge(int *arr, int left, int middle, int right, int *buffer)
+{
+    int i;
+    CDSA_MERGE_SORT_COUNT(merges, 1);
+    CDSA_MERGE_SORT_COUNT(moves, right - left);
+    merge_sort_merge_into(arr, buffer, left, middle, right);
+    for (i = left; i < right; i++)
+    {
+        arr[i] = buffer[i];
+    }
+}
+
+void merge_sort_bottom_up(int arr_count, int *arr)
+{
+    int *buffer, *src, *dst, *temp;
+    int width, left, middle, right;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (arr_count < 2)
+    {
+        return;
+    }
+    buffer = malloc(arr_count * sizeof(int));
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    width = CDSA_MERGE_SORT_INSERTION_THRESHOLD;
+    for (left = 0; left < arr_count; left = right)
+    {
+        right = (width < arr_count - left) ? left + width : arr_count;
+        merge_sort_insertion(arr, left, right);
+    }
+    if (width >= arr_count)
+    {
+        free(buffer);
+        return;
+    }
+    src = arr;
+    dst = buffer;
+    while (1) /* Loop termination is warranteed. */
+    {
+        for (left = 0; left < arr_count; left = right)
+        {
+            /* Written this way so that left + width cannot overflow. */
+            middle = (width < arr_count - left) ? left + width : arr_count;
+            right = (width < arr_count - middle) ? middle + width : arr_count;
+            if (middle == right || src[middle - 1] <= src[middle])
+            {
+                /* Already in order, a plain copy is enough. */
+                memcpy(dst + left, src + left, (right - left) * sizeof(int));
+            }
+            else
+            {
+                merge_sort_merge_into(src, dst, left, middle, right);
+            }
+        }
+        temp = src;
+        src = dst;
+        dst = temp;
+        if (width >= arr_count - width)
+        {
+            break;
+        }
+        width *= 2;
+    }
+    if (src != arr)
+    {
+        memcpy(arr, src, arr_count * sizeof(int));
+    }
+    free(buffer);
+}
+
+void merge_sort_merge_into(
+    const int *src,
+    int *dst,
+    int left,
+    int middle,
+    int right
+)
+{
+    merge_sort_merge_ranges(
+        src + left,
+        middle - left,
+        src + middle,
+        right - middle,
+        dst + left
+    );
+}
+
+void merge_sort_merge_ranges_branchless(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    int i = 0;
+    int j = 0;
+    int k = 0;
+    int x, y, take_b;
+    while (i < a_count && j < b_count)
+    {
+        /* No data-dependent branch, this compiles to conditional moves. */
+        x = a[i];
+        y = b[j];
+        take_b = y < x;
+        out[k++] = take_b ? y : x;
+        i += !take_b;
+        j += take_b;
+    }
+    /* One comparison per element taken, counted outside the hot loop. */
+    CDSA_MERGE_SORT_COUNT(comparisons, i + j);
+    while (i < a_count)
+    {
+        out[k++] = a[i++];
+    }
+    while (j < b_count)
+    {
+        out[k++] = b[j++];
+    }
+}
+
+/*
+ * Finish a vectorized merge: carry holds the elements still in the register,
+ * and at least one of the two tails is shorter than one vector. Merge carry
+ * with the short tail first, then the result with the long one.
+ */
+static void merge_sort_merge_tail(
+    const int *carry,
+    int carry_count,
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    int small[2 * CDSA_MERGE_SORT_SIMD_MAX_WIDTH];
+    if (a_count > b_count)
+    {
+        merge_sort_merge_ranges_branchless(
+            carry,
+            carry_count,
+            b,
+            b_count,
+            small
+        );
+        merge_sort_merge_ranges_branchless(
+            small,
+            carry_count + b_count,
+            a,
+            a_count,
+            out
+        );
+    }
+    else
+    {
+        merge_sort_merge_ranges_branchless(
+            carry,
+            carry_count,
+            a,
+            a_count,
+            small
+        );
+        merge_sort_merge_ranges_branchless(
+            small,
+            carry_count + a_count,
+            b,
+            b_count,
+            out
+        );
+    }
+}
+
+#if defined(CDSA_MERGE_SORT_X86_SIMD)
+
+/* Sort a bitonic 8-vector: compare-exchange at distances 4, 2, then 1. */
+__attribute__((target("avx2")))
+static __m256i merge_sort_bitonic_clean_avx2(__m256i v)
+{
+    __m256i p, mn, mx;
+    p = _mm256_permute2x128_si256(v, v, 1);
+    mn = _mm256_min_epi32(v, p);
+    mx = _mm256_max_epi32(v, p);
+    v = _mm256_blend_epi32(mn, mx, 0xF0);
+    p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    mn = _mm256_min_epi32(v, p);
+    mx = _mm256_max_epi32(v, p);
+    v = _mm256_blend_epi32(mn, mx, 0xCC);
+    p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    mn = _mm256_min_epi32(v, p);
+    mx = _mm256_max_epi32(v, p);
+    return _mm256_blend_epi32(mn, mx, 0xAA);
+}
+
+/* Merge two sorted 8-vectors: lo gets the 8 smallest, hi the 8 largest. */
+__attribute__((target("avx2")))
+static void merge_sort_bitonic_merge_avx2(__m256i *lo, __m256i *hi)
+{
+    __m256i reversed, mn, mx;
+    reversed = _mm256_permutevar8x32_epi32(
+        *hi,
+        _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)
+    );
+    mn = _mm256_min_epi32(*lo, reversed);
+    mx = _mm256_max_epi32(*lo, reversed);
+    *lo = merge_sort_bitonic_clean_avx2(mn);
+    *hi = merge_sort_bitonic_clean_avx2(mx);
+}
+
+__attribute__((target("avx2")))
+static void merge_sort_merge_ranges_avx2(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    __m256i lo, hi;
+    int carry[8];
+    int i = 8;
+    int j = 8;
+    int k = 8;
+    lo = _mm256_loadu_si256((const void *)a);
+    hi = _mm256_loadu_si256((const void *)b);
+    merge_sort_bitonic_merge_avx2(&lo, &hi);
+    _mm256_storeu_si256((void *)out, lo);
+    while (i + 8 <= a_count && j + 8 <= b_count)
+    {
+        /* The input with the smaller head feeds the next vector. */
+        if (a[i] <= b[j])
+        {
+            lo = _mm256_loadu_si256((const void *)(a + i));
+            i += 8;
+        }
+        else
+        {
+            lo = _mm256_loadu_si256((const void *)(b + j));
+            j += 8;
+        }
+        merge_sort_bitonic_merge_avx2(&lo, &hi);
+        _mm256_storeu_si256((void *)(out + k), lo);
+        k += 8;
+    }
+    _mm256_storeu_si256((void *)carry, hi);
+    merge_sort_merge_tail(
+        carry,
+        8,
+        a + i,
+        a_count - i,
+        b + j,
+        b_count - j,
+        out + k
+    );
+}
+
+/*
+ * Compare-exchange every lane of v with its partner p, the upper lane of each
+ * pair keeps the maximum. The masked intrinsics are used throughout because
+ * the unmasked ones trip -Winit-self inside the GCC headers.
+ */
+__attribute__((target("avx512f")))
+static __m512i merge_sort_bitonic_step_avx512(
+    __m512i v,
+    __m512i p,
+    __mmask16 upper
+)
+{
+    __m512i mn = _mm512_mask_min_epi32(v, (__mmask16)~upper, v, p);
+    return _mm512_mask_max_epi32(mn, upper, v, p);
+}
+
+/* Sort a bitonic 16-vector: distances 8, 4, 2, then 1. */
+__attribute__((target("avx512f")))
+static __m512i merge_sort_bitonic_clean_avx512(__m512i v)
+{
+    v = merge_sort_bitonic_step_avx512(
+        v,
+        _mm512_mask_shuffle_i32x4(v, 0xFFFF, v, v, _MM_SHUFFLE(1, 0, 3, 2)),
+        0xFF00
+    );
+    v = merge_sort_bitonic_step_avx512(
+        v,
+        _mm512_mask_shuffle_i32x4(v, 0xFFFF, v, v, _MM_SHUFFLE(2, 3, 0, 1)),
+        0xF0F0
+    );
+    v = merge_sort_bitonic_step_avx512(
+        v,
+        _mm512_mask_shuffle_epi32(v, 0xFFFF, v, _MM_PERM_BADC),
+        0xCCCC
+    );
+    return merge_sort_bitonic_step_avx512(
+        v,
+        _mm512_mask_shuffle_epi32(v, 0xFFFF, v, _MM_PERM_CDAB),
+        0xAAAA
+    );
+}
+
+/* Merge two sorted 16-vectors: lo gets the 16 smallest, hi the 16 largest. */
+__attribute__((target("avx512f")))
+static void merge_sort_bitonic_merge_avx512(__m512i *lo, __m512i *hi)
+{
+    __m512i reversed, mn, mx;
+    reversed = _mm512_mask_permutexvar_epi32(
+        *hi,
+        0xFFFF,
+        _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+        *hi
+    );
+    mn = _mm512_mask_min_epi32(*lo, 0xFFFF, *lo, reversed);
+    mx = _mm512_mask_max_epi32(*lo, 0xFFFF, *lo, reversed);
+    *lo = merge_sort_bitonic_clean_avx512(mn);
+    *hi = merge_sort_bitonic_clean_avx512(mx);
+}
+
+__attribute__((target("avx512f")))
+static void merge_sort_merge_ranges_avx512(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    __m512i lo, hi;
+    int carry[16];
+    int i = 16;
+    int j = 16;
+    int k = 16;
+    lo = _mm512_loadu_si512(a);
+    hi = _mm512_loadu_si512(b);
+    merge_sort_bitonic_merge_avx512(&lo, &hi);
+    _mm512_storeu_si512(out, lo);
+    while (i + 16 <= a_count && j + 16 <= b_count)
+    {
+        /* The input with the smaller head feeds the next vector. */
+        if (a[i] <= b[j])
+        {
+            lo = _mm512_loadu_si512(a + i);
+            i += 16;
+        }
+        else
+        {
+            lo = _mm512_loadu_si512(b + j);
+            j += 16;
+        }
+        merge_sort_bitonic_merge_avx512(&lo, &hi);
+        _mm512_storeu_si512(out + k, lo);
+        k += 16;
+    }
+    _mm512_storeu_si512(carry, hi);
+    merge_sort_merge_tail(
+        carry,
+        16,
+        a + i,
+        a_count - i,
+        b + j,
+        b_count - j,
+        out + k
+    );
+}
+
+#elif defined(CDSA_MERGE_SORT_NEON_SIMD)
+
+/* Sort a bitonic 4-vector: compare-exchange at distances 2, then 1. */
+static int32x4_t merge_sort_bitonic_clean_neon(int32x4_t v)
+{
+    int32x4_t p, mn, mx;
+    p = vextq_s32(v, v, 2);
+    mn = vminq_s32(v, p);
+    mx = vmaxq_s32(v, p);
+    v = vcombine_s32(vget_low_s32(mn), vget_high_s32(mx));
+    p = vrev64q_s32(v);
+    mn = vminq_s32(v, p);
+    mx = vmaxq_s32(v, p);
+    return vtrn1q_s32(mn, mx);
+}
+
+/* Merge two sorted 4-vectors: lo gets the 4 smallest, hi the 4 largest. */
+static void merge_sort_bitonic_merge_neon(int32x4_t *lo, int32x4_t *hi)
+{
+    int32x4_t reversed, mn, mx;
+    reversed = vrev64q_s32(*hi);
+    reversed = vextq_s32(reversed, reversed, 2);
+    mn = vminq_s32(*lo, reversed);
+    mx = vmaxq_s32(*lo, reversed);
+    *lo = merge_sort_bitonic_clean_neon(mn);
+    *hi = merge_sort_bitonic_clean_neon(mx);
+}
+
+static void merge_sort_merge_ranges_neon(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    int32x4_t lo, hi;
+    int carry[4];
+    int i = 4;
+    int j = 4;
+    int k = 4;
+    lo = vld1q_s32(a);
+    hi = vld1q_s32(b);
+    merge_sort_bitonic_merge_neon(&lo, &hi);
+    vst1q_s32(out, lo);
+    while (i + 4 <= a_count && j + 4 <= b_count)
+    {
+        /* The input with the smaller head feeds the next vector. */
+        if (a[i] <= b[j])
+        {
+            lo = vld1q_s32(a + i);
+            i += 4;
+        }
+        else
+        {
+            lo = vld1q_s32(b + j);
+            j += 4;
+        }
+        merge_sort_bitonic_merge_neon(&lo, &hi);
+        vst1q_s32(out + k, lo);
+        k += 4;
+    }
+    vst1q_s32(carry, hi);
+    merge_sort_merge_tail(
+        carry,
+        4,
+        a + i,
+        a_count - i,
+        b + j,
+        b_count - j,
+        out + k
+    );
+}
+
+#endif
+
+void merge_sort_merge_ranges(
+    const int *a,
+    int a_count,
+    const int *b,
+    int b_count,
+    int *out
+)
+{
+    CDSA_MERGE_SORT_COUNT(moves, a_count + b_count);
+#if defined(CDSA_MERGE_SORT_X86_SIMD)
+    if (a_count >= 16 && b_count >= 16 && __builtin_cpu_supports("avx512f"))
+    {
+        merge_sort_merge_ranges_avx512(a, a_count, b, b_count, out);
+        return;
+    }
+    if (a_count >= 8 && b_count >= 8 && __builtin_cpu_supports("avx2"))
+    {
+        merge_sort_merge_ranges_avx2(a, a_count, b, b_count, out);
+        return;
+    }
+#elif defined(CDSA_MERGE_SORT_NEON_SIMD)
+    if (a_count >= 4 && b_count >= 4)
+    {
+        merge_sort_merge_ranges_neon(a, a_count, b, b_count, out);
+        return;
+    }
+#endif
+    merge_sort_merge_ranges_branchless(a, a_count, b, b_count, out);
+}
+
+void merge_sort_insertion(int *arr, int left, int right)
+{
+    int i, j, key;
+    for (i = left + 1; i < right; i++)
+    {
+        key = arr[i];
+        for (j = i; j > left && arr[j - 1] > key; j--)
+        {
+            arr[j] = arr[j - 1];
+        }
+        arr[j] = key;
+    }
+}
+
+void merge_sort_natural(int arr_count, int *arr)
+{
+    int run_start[CDSA_MERGE_SORT_MAX_RUNS];
+    int run_length[CDSA_MERGE_SORT_MAX_RUNS];
+    int run_power[CDSA_MERGE_SORT_MAX_RUNS];
+    int top = 0;
+    int *buffer;
+    int left, right, power;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (arr_count < 2)
+    {
+        return;
+    }
+    right = merge_sort_find_run(arr, 0, arr_count);
+    if (right == arr_count)
+    {
+        return;
+    }
+    buffer = malloc(arr_count * sizeof(int));
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    run_start[0] = 0;
+    run_length[0] = right;
+    top = 1;
+    while (right < arr_count)
+    {
+        left = right;
+        right = merge_sort_find_run(arr, left, arr_count);
+        power = merge_sort_run_power(
+            run_start[top - 1],
+            run_length[top - 1],
+            right - left,
+            arr_count
+        );
+        /*
+         * run_power[i] is the power of the boundary between runs i and i + 1.
+         * Merge the two topmost runs while that boundary is deeper than the
+         * new one.
+         */
+        while (top > 1 && run_power[top - 2] > power)
+        {
+            merge_sort_natural_merge_top(
+                run_start,
+                run_length,
+                top,
+                arr,
+                buffer
+            );
+            top--;
+        }
+        run_power[top - 1] = power;
+        run_start[top] = left;
+        run_length[top] = right - left;
+        top++;
+    }
+    while (top > 1)
+    {
+        merge_sort_natural_merge_top(
+            run_start,
+            run_length,
+            top,
+            arr,
+            buffer
+        );
+        top--;
+    }
+    free(buffer);
+}
+
+void merge_sort_natural_merge_top(
+    const int *run_start,
+    int *run_length,
+    int top,
+    int *arr,
+    int *buffer
+)
+{
+    int middle = run_start[top - 1];
+    if (arr[middle - 1] > arr[middle])
+    {
+        merge_sort_merge(
+            arr,
+            run_start[top - 2],
+            middle,
+            middle + run_length[top - 1],
+            buffer
+        );
+    }
+    run_length[top - 2] += run_length[top - 1];
+}
+
+int merge_sort_find_run(int *arr, int left, int arr_count)
+{
+    int right = left + 1;
+    int i, j, temp;
+    if (right < arr_count)
+    {
+        if (arr[right] < arr[left])
+        {
+            /* Strictly descending, so reversing it keeps the sort stable. */
+            while (right + 1 < arr_count && arr[right + 1] < arr[right])
+            {
+                right++;
+            }
+            right++;
+            for (i = left, j = right - 1; i < j; i++, j--)
+            {
+                temp = arr[i];
+                arr[i] = arr[j];
+                arr[j] = temp;
+            }
+        }
+        else
+        {
+            while (right < arr_count && arr[right - 1] <= arr[right])
+            {
+                right++;
+            }
+        }
+    }
+    if (right - left < CDSA_MERGE_SORT_INSERTION_THRESHOLD)
+    {
+        /* Extend short runs to the minimum length. */
+        right = (CDSA_MERGE_SORT_INSERTION_THRESHOLD < arr_count - left)
+            ? left + CDSA_MERGE_SORT_INSERTION_THRESHOLD
+            : arr_count;
+        merge_sort_insertion(arr, left, right);
+    }
+    return right;
+}
+
+int merge_sort_run_power(int s1, int n1, int n2, int arr_count)
+{
+    /*
+     * Twice the midpoints of both runs, kept unsigned long so that they
+     * cannot overflow even when arr_count is close to INT_MAX.
+     */
+    unsigned long a = 2UL * s1 + n1;
+    unsigned long b = a + n1 + n2;
+    unsigned long n = (unsigned long)arr_count;
+    int power = 0;
+    while (1) /* Loop termination is warranteed since a < b. */
+    {
+        power++;
+        if (a >= n)
+        {
+            a -= n;
+            b -= n;
+        }
+        else if (b >= n)
+        {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+/* Index of the first element of arr[0, count) that is not less than key. */
+static int merge_sort_lower_bound(const int *arr, int count, int key)
+{
+    int low = 0;
+    int high = count;
+    int middle;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        if (arr[middle] < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+/* Index of the first element of arr[0, count) that is greater than key. */
+static int merge_sort_upper_bound(const int *arr, int count, int key)
+{
+    int low = 0;
+    int high = count;
+    int middle;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        if (arr[middle] <= key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+void merge_sort_in_place(int arr_count, int *arr)
+{
+    int width, left, middle, right;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    width = CDSA_MERGE_SORT_INSERTION_THRESHOLD;
+    for (left = 0; left < arr_count; left = right)
+    {
+        right = (width < arr_count - left) ? left + width : arr_count;
+        merge_sort_insertion(arr, left, right);
+    }
+    while (width < arr_count)
+    {
+        for (left = 0; arr_count - left > width; left = right)
+        {
+            middle = left + width;
+            right = (width < arr_count - middle) ? middle + width : arr_count;
+            merge_sort_merge_in_place(arr, left, middle, right);
+        }
+        if (width >= arr_count - width)
+        {
+            break;
+        }
+        width *= 2;
+    }
+}
+
+void merge_sort_merge_in_place(int *arr, int left, int middle, int right)
+{
+    int small[CDSA_MERGE_SORT_IN_PLACE_BUFFER];
+    int i, j, k, cut1, cut2;
+    while (left < middle && middle < right && arr[middle - 1] > arr[middle])
+    {
+        if (middle - left <= CDSA_MERGE_SORT_IN_PLACE_BUFFER)
+        {
+            /* Move the left side out of the way and merge forward. */
+            memcpy(small, arr + left, (middle - left) * sizeof(int));
+            for (i = 0, j = middle, k = left; i < middle - left; k++)
+            {
+                if (j < right && arr[j] < small[i]) arr[k] = arr[j++];
+                else arr[k] = small[i++];
+            }
+            return;
+        }
+        if (right - middle <= CDSA_MERGE_SORT_IN_PLACE_BUFFER)
+        {
+            /* Move the right side out of the way and merge backward. */
+            memcpy(small, arr + middle, (right - middle) * sizeof(int));
+            for (i = right - middle, j = middle, k = right; i > 0; )
+            {
+                k--;
+                if (j > left && small[i - 1] < arr[j - 1]) arr[k] = arr[--j];
+                else arr[k] = small[--i];
+            }
+            return;
+        }
+        /*
+         * Cut the longer side in half and the other side at the matching
+         * position, then rotate the two inner blocks into place. This leaves
+         * two independent, smaller merges.
+         */
+        if (middle - left >= right - middle)
+        {
+            cut1 = left + (middle - left) / 2;
+            cut2 = middle + merge_sort_lower_bound(
+                arr + middle,
+                right - middle,
+                arr[cut1]
+            );
+        }
+        else
+        {
+            cut2 = middle + (right - middle) / 2;
+            cut1 = left + merge_sort_upper_bound(
+                arr + left,
+                middle - left,
+                arr[cut2]
+            );
+        }
+        merge_sort_rotate(arr, cut1, middle, cut2);
+        k = cut1 + (cut2 - middle);
+        /* Recurse into the smaller merge and loop on the larger one. */
+        if (k - left < right - k)
+        {
+            merge_sort_merge_in_place(arr, left, cut1, k);
+            left = k;
+            middle = cut2;
+        }
+        else
+        {
+            merge_sort_merge_in_place(arr, k, cut2, right);
+            right = k;
+            middle = cut1;
+        }
+    }
+}
+
+void merge_sort_rotate(int *arr, int left, int middle, int right)
+{
+    int i, j, temp;
+    /* Three reversals: (A^r B^r)^r == B A. */
+    for (i = left, j = middle - 1; i < j; i++, j--)
+    {
+        temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+    for (i = middle, j = right - 1; i < j; i++, j--)
+    {
+        temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+    for (i = left, j = right - 1; i < j; i++, j--)
+    {
+        temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+int merge_sort_with_mode(int arr_count, int *arr, int mode)
+{
+    int *buffer;
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Merge sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_MERGE_SORT_OK;
+    if (mode == CDSA_MERGE_SORT_MODE_BUFFERED)
+    {
+        buffer = malloc(arr_count * sizeof(int));
+        if (buffer != NULL)
+        {
+            merge_sort_recursive(arr, 0, arr_count, buffer);
+            free(buffer);
+            return CDSA_MERGE_SORT_OK;
+        }
+        /* Not enough memory for the buffer, the in-place sort still works. */
+    }
+    merge_sort_in_place(arr_count, arr);
+    return CDSA_MERGE_SORT_OK;
+}
+
+static MergeSortTask *merge_sort_new_task(int kind, MergeSortTask *parent)
+{
+    MergeSortTask *task = malloc(sizeof(MergeSortTask));
+    if (task == NULL)
+    {
+        return NULL;
+    }
+    memset(task, 0, sizeof(MergeSortTask));
+    task->kind = kind;
+    task->parent = parent;
+    return task;
+}
+
+static int merge_sort_init_deque(MergeSortDeque *deque)
+{
+    deque->capacity = 64;
+    deque->tasks = malloc(deque->capacity * sizeof(MergeSortTask *));
+    if (deque->tasks == NULL)
+    {
+        return 1;
+    }
+    deque->head = 0;
+    deque->count = 0;
+    pthread_mutex_init(&deque->lock, NULL);
+    return 0;
+}
+
+static void merge_sort_destroy_deque(MergeSortDeque *deque)
+{
+    pthread_mutex_destroy(&deque->lock);
+    free(deque->tasks);
+    deque->tasks = NULL;
+}
+
+static int merge_sort_push_deque(MergeSortDeque *deque, MergeSortTask *task)
+{
+    MergeSortTask **tasks;
+    int i;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count == deque->capacity)
+    {
+        tasks = malloc(2 * deque->capacity * sizeof(MergeSortTask *));
+        if (tasks == NULL)
+        {
+            pthread_mutex_unlock(&deque->lock);
+            return 1;
+        }
+        for (i = 0; i < deque->count; i++)
+        {
+            tasks[i] = deque->tasks[(deque->head + i) % deque->capacity];
+        }
+        free(deque->tasks);
+        deque->tasks = tasks;
+        deque->capacity *= 2;
+        deque->head = 0;
+    }
+    deque->tasks[(deque->head + deque->count) % deque->capacity] = task;
+    deque->count++;
+    pthread_mutex_unlock(&deque->lock);
+    return 0;
+}
+
+static MergeSortTask *merge_sort_pop_deque(MergeSortDeque *deque, int steal)
+{
+    MergeSortTask *task = NULL;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count > 0)
+    {
+        deque->count--;
+        if (steal)
+        {
+            task = deque->tasks[deque->head];
+            deque->head = (deque->head + 1) % deque->capacity;
+        }
+        else
+        {
+            task = deque->tasks[
+                (deque->head + deque->count) % deque->capacity
+            ];
+        }
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return task;
+}
+
+static void merge_sort_run_task(MergeSortPool *pool, int id, MergeSortTask *t);
+
+static void merge_sort_push_task(MergeSortPool *pool, int id, MergeSortTask *t)
+{
+    if (merge_sort_push_deque(&pool->deques[id], t) != 0)
+    {
+        /* The deque could not grow, so just do the work right here. */
+        merge_sort_run_task(pool, id, t);
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->queued++;
+    if (pool->sleeping > 0)
+    {
+        pthread_cond_signal(&pool->wake);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static MergeSortTask *merge_sort_take_task(MergeSortPool *pool, int id)
+{
+    MergeSortTask *task;
+    int i;
+    task = merge_sort_pop_deque(&pool->deques[id], 0);
+    for (i = 1; task == NULL && i < pool->num_workers; i++)
+    {
+        task = merge_sort_pop_deque(
+            &pool->deques[(id + i) % pool->num_workers],
+            1
+        );
+    }
+    if (task != NULL)
+    {
+        pthread_mutex_lock(&pool->lock);
+        pool->queued--;
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return task;
+}
+
+static void merge_sort_finish_task(
+    MergeSortPool *pool,
+    int id,
+    MergeSortTask *t
+)
+{
+    MergeSortTask *parent = t->parent;
+    int pending;
+    free(t);
+    pthread_mutex_lock(&pool->lock);
+    if (parent == NULL)
+    {
+        pool->done = 1;
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+        return;
+    }
+    pending = --parent->pending;
+    pthread_mutex_unlock(&pool->lock);
+    if (pending > 0)
+    {
+        return;
+    }
+    if (parent->kind == CDSA_MERGE_SORT_TASK_JOIN_MERGE)
+    {
+        merge_sort_finish_task(pool, id, parent);
+        return;
+    }
+    /* Both halves are sorted into the other array, merge them back. */
+    parent->kind = CDSA_MERGE_SORT_TASK_MERGE;
+    parent->a = (parent->to_dst ? parent->src : parent->dst) + parent->left;
+    parent->a_count = (parent->right - parent->left) / 2;
+    parent->b = parent->a + parent->a_count;
+    parent->b_count = parent->right - parent->left - parent->a_count;
+    parent->out = (parent->to_dst ? parent->dst : parent->src) + parent->left;
+    merge_sort_run_task(pool, id, parent);
+}
+
+static void merge_sort_run_sort_task(
+    MergeSortPool *pool,
+    int id,
+    MergeSortTask *t
+)
+{
+    MergeSortTask *first, *second;
+    int middle;
+    if (t->right - t->left > CDSA_MERGE_SORT_PARALLEL_GRAIN)
+    {
+        middle = t->left + (t->right - t->left) / 2;
+        first = merge_sort_new_task(CDSA_MERGE_SORT_TASK_SORT, t);
+        second = merge_sort_new_task(CDSA_MERGE_SORT_TASK_SORT, t);
+        if (first != NULL && second != NULL)
+        {
+            first->src = second->src = t->src;
+            first->dst = second->dst = t->dst;
+            first->to_dst = second->to_dst = !t->to_dst;
+            first->left = t->left;
+            first->right = second->left = middle;
+            second->right = t->right;
+            t->kind = CDSA_MERGE_SORT_TASK_JOIN_SORT;
+            t->pending = 2;
+            merge_sort_push_task(pool, id, second);
+            merge_sort_run_task(pool, id, first);
+            return;
+        }
+        /* Out of memory for tasks, fall back to sorting sequentially. */
+        free(first);
+        free(second);
+    }
+    merge_sort_recursive(t->src, t->left, t->right, t->dst);
+    if (t->to_dst)
+    {
+        memcpy(
+            t->dst + t->left,
+            t->src + t->left,
+            (t->right - t->left) * sizeof(int)
+        );
+    }
+    merge_sort_finish_task(pool, id, t);
+}
+
+static void merge_sort_run_merge_task(
+    MergeSortPool *pool,
+    int id,
+    MergeSortTask *t
+)
+{
+    MergeSortTask *first, *second;
+    int i, j;
+    if (t->a_count + t->b_count > CDSA_MERGE_SORT_PARALLEL_GRAIN)
+    {
+        /*
+         * Binary-split merge: cut the larger range in half, and cut the other
+         * one at the matching position, so that every element on the left
+         * side goes before every element on the right side.
+         */
+        if (t->a_count >= t->b_count)
+        {
+            i = t->a_count / 2;
+            j = merge_sort_lower_bound(t->b, t->b_count, t->a[i]);
+        }
+        else
+        {
+            j = t->b_count / 2;
+            i = merge_sort_upper_bound(t->a, t->a_count, t->b[j]);
+        }
+        first = merge_sort_new_task(CDSA_MERGE_SORT_TASK_MERGE, t);
+        second = merge_sort_new_task(CDSA_MERGE_SORT_TASK_MERGE, t);
+        if (first != NULL && second != NULL)
+        {
+            first->a = t->a;
+            first->a_count = i;
+            first->b = t->b;
+            first->b_count = j;
+            first->out = t->out;
+            second->a = t->a + i;
+            second->a_count = t->a_count - i;
+            second->b = t->b + j;
+            second->b_count = t->b_count - j;
+            second->out = t->out + i + j;
+            t->kind = CDSA_MERGE_SORT_TASK_JOIN_MERGE;
+            t->pending = 2;
+            merge_sort_push_task(pool, id, second);
+            merge_sort_run_task(pool, id, first);
+            return;
+        }
+        /* Out of memory for tasks, fall back to merging sequentially. */
+        free(first);
+        free(second);
+    }
+    merge_sort_merge_ranges(t->a, t->a_count, t->b, t->b_count, t->out);
+    merge_sort_finish_task(pool, id, t);
+}
+
+static void merge_sort_run_task(MergeSortPool *pool, int id, MergeSortTask *t)
+{
+    if (t->kind == CDSA_MERGE_SORT_TASK_SORT)
+    {
+        merge_sort_run_sort_task(pool, id, t);
+    }
+    else
+    {
+        merge_sort_run_merge_task(pool, id, t);
+    }
+}
+
+static void merge_sort_work(MergeSortPool *pool, int id)
+{
+    MergeSortTask *task;
+    int done;
+    while (1) /* Loop termination is warranteed once the root task is done. */
+    {
+        task = merge_sort_take_task(pool, id);
+        if (task != NULL)
+        {
+            merge_sort_run_task(pool, id, task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (pool->queued == 0 && !pool->done)
+        {
+            pool->sleeping++;
+            pthread_cond_wait(&pool->wake, &pool->lock);
+            pool->sleeping--;
+        }
+        done = pool->done;
+        pthread_mutex_unlock(&pool->lock);
+        if (done)
+        {
+            return;
+        }
+    }
+}
+
+static void *merge_sort_worker_main(void *arg)
+{
+    MergeSortWorker *worker = arg;
+    merge_sort_work(worker->pool, worker->id);
+    return NULL;
+}
+
+void merge_sort_parallel(int arr_count, int *arr, int num_threads)
+{
+    MergeSortPool pool;
+    MergeSortWorker workers[CDSA_MERGE_SORT_MAX_THREADS];
+    pthread_t threads[CDSA_MERGE_SORT_MAX_THREADS];
+    unsigned char started[CDSA_MERGE_SORT_MAX_THREADS];
+    MergeSortTask *root;
+    int *buffer;
+    int i;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (num_threads > CDSA_MERGE_SORT_MAX_THREADS)
+    {
+        num_threads = CDSA_MERGE_SORT_MAX_THREADS;
+    }
+    if (num_threads <= 1 || arr_count <= CDSA_MERGE_SORT_PARALLEL_GRAIN)
+    {
+        merge_sort(arr_count, arr);
+        return;
+    }
+    buffer = malloc(arr_count * sizeof(int));
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    pool.deques = malloc(num_threads * sizeof(MergeSortDeque));
+    root = merge_sort_new_task(CDSA_MERGE_SORT_TASK_SORT, NULL);
+    if (pool.deques == NULL || root == NULL)
+    {
+        fprintf(stderr, "Failed to allocate thread pool. Exiting.\n");
+        exit(1);
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        if (merge_sort_init_deque(&pool.deques[i]) != 0)
+        {
+            fprintf(stderr, "Failed to allocate thread pool. Exiting.\n");
+            exit(1);
+        }
+    }
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.wake, NULL);
+    pool.num_workers = num_threads;
+    pool.queued = 0;
+    pool.sleeping = 0;
+    pool.done = 0;
+    root->src = arr;
+    root->dst = buffer;
+    root->left = 0;
+    root->right = arr_count;
+    root->to_dst = 0;
+    merge_sort_push_task(&pool, 0, root);
+    /*
+     * The calling thread is worker 0. A thread that fails to start only
+     * leaves its deque empty, the remaining workers still finish the sort.
+     */
+    for (i = 1; i < num_threads; i++)
+    {
+        workers[i].pool = &pool;
+        workers[i].id = i;
+        started[i] = pthread_create(
+            &threads[i],
+            NULL,
+            merge_sort_worker_main,
+            &workers[i]
+        ) == 0;
+    }
+    merge_sort_work(&pool, 0);
+    for (i = 1; i < num_threads; i++)
+    {
+        if (started[i]) (void)pthread_join(threads[i], NULL);
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        merge_sort_destroy_deque(&pool.deques[i]);
+    }
+    pthread_cond_destroy(&pool.wake);
+    pthread_mutex_destroy(&pool.lock);
+    free(pool.deques);
+    free(buffer);
+}
+
+static void *merge_sort_io_main(void *arg)
+{
+    MergeSortIO *io = arg;
+    MergeSortIORequest *request;
+    size_t count;
+    int failed;
+    while (1) /* Loop termination is warranteed once stop is set. */
+    {
+        pthread_mutex_lock(&io->lock);
+        while (io->head == NULL && !io->stop)
+        {
+            pthread_cond_wait(&io->submitted, &io->lock);
+        }
+        if (io->head == NULL)
+        {
+            pthread_mutex_unlock(&io->lock);
+            return NULL;
+        }
+        request = io->head;
+        io->head = request->next;
+        if (io->head == NULL) io->tail = NULL;
+        pthread_mutex_unlock(&io->lock);
+        failed = 0;
+        if (request->is_write)
+        {
+            if (request->position != NULL)
+            {
+                failed = fgetpos(request->file, request->position) != 0;
+            }
+            count = failed ? 0 : fwrite(
+                request->data,
+                sizeof(int),
+                request->count,
+                request->file
+            );
+            failed = failed || count != (size_t)request->count;
+        }
+        else
+        {
+            if (request->position != NULL)
+            {
+                failed = fsetpos(request->file, request->position) != 0;
+            }
+            count = failed ? 0 : fread(
+                request->data,
+                sizeof(int),
+                request->count,
+                request->file
+            );
+            failed = failed || ferror(request->file);
+            if (request->position != NULL && !failed)
+            {
+                failed = fgetpos(request->file, request->position) != 0;
+            }
+        }
+        pthread_mutex_lock(&io->lock);
+        request->count = (int)count;
+        request->failed = failed;
+        request->done = 1;
+        pthread_cond_broadcast(&io->completed);
+        pthread_mutex_unlock(&io->lock);
+    }
+}
+
+static int merge_sort_start_io(MergeSortIO *io)
+{
+    io->head = NULL;
+    io->tail = NULL;
+    io->stop = 0;
+    pthread_mutex_init(&io->lock, NULL);
+    pthread_cond_init(&io->submitted, NULL);
+    pthread_cond_init(&io->completed, NULL);
+    if (pthread_create(&io->thread, NULL, merge_sort_io_main, io) != 0)
+    {
+        pthread_cond_destroy(&io->completed);
+        pthread_cond_destroy(&io->submitted);
+        pthread_mutex_destroy(&io->lock);
+        return 1;
+    }
+    return 0;
+}
+
+static void merge_sort_stop_io(MergeSortIO *io)
+{
+    pthread_mutex_lock(&io->lock);
+    io->stop = 1;
+    pthread_cond_signal(&io->submitted);
+    pthread_mutex_unlock(&io->lock);
+    (void)pthread_join(io->thread, NULL);
+    pthread_cond_destroy(&io->completed);
+    pthread_cond_destroy(&io->submitted);
+    pthread_mutex_destroy(&io->lock);
+}
+
+static void merge_sort_submit_io(
+    MergeSortIO *io,
+    MergeSortIORequest *request,
+    int is_write,
+    int count
+)
+{
+    request->is_write = is_write;
+    request->count = count;
+    request->done = 0;
+    request->failed = 0;
+    request->next = NULL;
+    pthread_mutex_lock(&io->lock);
+    if (io->tail == NULL) io->head = request;
+    else io->tail->next = request;
+    io->tail = request;
+    pthread_cond_signal(&io->submitted);
+    pthread_mutex_unlock(&io->lock);
+}
+
+/* Wait for a submitted request. Return the number of ints, or -1 on error. */
+static int merge_sort_wait_io(MergeSortIO *io, MergeSortIORequest *request)
+{
+    pthread_mutex_lock(&io->lock);
+    while (!request->done)
+    {
+        pthread_cond_wait(&io->completed, &io->lock);
+    }
+    pthread_mutex_unlock(&io->lock);
+    return request->failed ? -1 : request->count;
+}
+
+static int merge_sort_push_run(
+    MergeSortRunList *runs,
+    const fpos_t *position,
+    unsigned long length
+)
+{
+    fpos_t *positions;
+    unsigned long *lengths;
+    int capacity;
+    if (runs->count == runs->capacity)
+    {
+        capacity = runs->capacity ? 2 * runs->capacity : 16;
+        positions = malloc(capacity * sizeof(fpos_t));
+        lengths = malloc(capacity * sizeof(unsigned long));
+        if (positions == NULL || lengths == NULL)
+        {
+            free(positions);
+            free(lengths);
+            return CDSA_MERGE_SORT_ALLOC_FAILED;
+        }
+        if (runs->count > 0)
+        {
+            memcpy(positions, runs->position, runs->count * sizeof(fpos_t));
+            memcpy(
+                lengths,
+                runs->length,
+                runs->count * sizeof(unsigned long)
+            );
+        }
+        free(runs->position);
+        free(runs->length);
+        runs->position = positions;
+        runs->length = lengths;
+        runs->capacity = capacity;
+    }
+    runs->position[runs->count] = *position;
+    runs->length[runs->count] = length;
+    runs->count++;
+    return CDSA_MERGE_SORT_OK;
+}
+
+static void merge_sort_clear_runs(MergeSortRunList *runs)
+{
+    if (runs->file != NULL) fclose(runs->file);
+    free(runs->position);
+    free(runs->length);
+    runs->file = NULL;
+    runs->position = NULL;
+    runs->length = NULL;
+    runs->count = 0;
+    runs->capacity = 0;
+}
+
+/* Wait for the write of a sorted run of count ints, then record the run. */
+static int merge_sort_finish_run(
+    MergeSortIO *io,
+    MergeSortIORequest *request,
+    int count,
+    MergeSortRunList *runs
+)
+{
+    if (merge_sort_wait_io(io, request) != count)
+    {
+        fprintf(stderr, "External merge sort failed: failed to write.\n");
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    if (merge_sort_push_run(runs, request->position, count)
+        != CDSA_MERGE_SORT_OK)
+    {
+        fprintf(
+            stderr,
+            "External merge sort failed: failed to allocate run list.\n"
+        );
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    return CDSA_MERGE_SORT_OK;
+}
+
+/*
+ * Split the input into sorted runs of memory_count / 3 ints. Two chunks
+ * alternate: one is being sorted while the I/O thread writes the previous
+ * one and reads the next one. The third part is the merge sort scratch.
+ */
+static int merge_sort_generate_runs(
+    MergeSortIO *io,
+    FILE *input,
+    MergeSortRunList *runs,
+    int *memory,
+    int memory_count
+)
+{
+    MergeSortIORequest read_request, write_request[2];
+    fpos_t position[2];
+    int chunk = memory_count / 3;
+    int *chunks[2];
+    int *scratch = memory + 2 * chunk;
+    int current = 0;
+    int pending = 0; /* Ints being written from chunks[1 - current] */
+    int count;
+    int rc = CDSA_MERGE_SORT_OK;
+    chunks[0] = memory;
+    chunks[1] = memory + chunk;
+    read_request.file = input;
+    read_request.position = NULL;
+    write_request[0].file = write_request[1].file = runs->file;
+    write_request[0].position = &position[0];
+    write_request[1].position = &position[1];
+    read_request.data = chunks[current];
+    merge_sort_submit_io(io, &read_request, 0, chunk);
+    count = merge_sort_wait_io(io, &read_request);
+    while (count > 0)
+    {
+        /* Prefetch the next chunk into the other half while sorting. The
+         * I/O thread serves requests in order, so this read only starts
+         * once the previous run is written out of that half. */
+        read_request.data = chunks[1 - current];
+        merge_sort_submit_io(io, &read_request, 0, chunk);
+        merge_sort_with_buffer(count, chunks[current], scratch);
+        /* Runs are recorded in file order: the previous one first. */
+        if (pending > 0)
+        {
+            rc = merge_sort_finish_run(
+                io,
+                &write_request[1 - current],
+                pending,
+                runs
+            );
+            if (rc != CDSA_MERGE_SORT_OK)
+            {
+                (void)merge_sort_wait_io(io, &read_request);
+                return rc;
+            }
+        }
+        write_request[current].data = chunks[current];
+        merge_sort_submit_io(io, &write_request[current], 1, count);
+        pending = count;
+        count = merge_sort_wait_io(io, &read_request);
+        current = 1 - current;
+    }
+    if (pending > 0)
+    {
+        rc = merge_sort_finish_run(
+            io,
+            &write_request[1 - current],
+            pending,
+            runs
+        );
+    }
+    if (count < 0)
+    {
+        fprintf(stderr, "External merge sort failed: failed to read.\n");
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    return rc;
+}
+
+/* Ask the I/O thread for the next block of a run, if any is left. */
+static void merge_sort_refill_run(
+    MergeSortIO *io,
+    FILE *file,
+    MergeSortRunReader *reader,
+    int slot,
+    int block_count
+)
+{
+    int count = (reader->remaining < (unsigned long)block_count)
+        ? (int)reader->remaining
+        : block_count;
+    reader->request[slot].file = file;
+    reader->request[slot].position = &reader->position;
+    reader->request[slot].data = reader->block[slot];
+    reader->remaining -= count;
+    merge_sort_submit_io(io, &reader->request[slot], 0, count);
+}
+
+/*
+ * Move a run reader to its next element. Return 0 on success (the reader
+ * might be exhausted), or 1 on I/O error.
+ */
+static int merge_sort_advance_run(
+    MergeSortIO *io,
+    FILE *file,
+    MergeSortRunReader *reader,
+    int block_count
+)
+{
+    int next;
+    reader->index++;
+    if (reader->index < reader->request[reader->current].count) return 0;
+    next = 1 - reader->current;
+    if (merge_sort_wait_io(io, &reader->request[next]) < 0) return 1;
+    if (reader->request[next].count == 0)
+    {
+        reader->exhausted = 1;
+        return 0;
+    }
+    if (reader->remaining > 0)
+    {
+        merge_sort_refill_run(io, file, reader, reader->current, block_count);
+    }
+    else
+    {
+        /* Nothing left to read, mark the spent block as empty. */
+        reader->request[reader->current].count = 0;
+        reader->request[reader->current].done = 1;
+        reader->request[reader->current].failed = 0;
+    }
+    reader->current = next;
+    reader->index = 0;
+    return 0;
+}
+
+/* Whether the head of run x goes before the head of run y. */
+static int merge_sort_run_before(
+    const MergeSortRunReader *readers,
+    int x,
+    int y
+)
+{
+    int a, b;
+    if (readers[x].exhausted) return 0;
+    if (readers[y].exhausted) return 1;
+    a = readers[x].block[readers[x].current][readers[x].index];
+    b = readers[y].block[readers[y].current][readers[y].index];
+    return a < b || (a == b && x < y);
+}
+
+/*
+ * Merge runs [first, first + k) of the list into output through a loser tree,
+ * with memory split into 2k input blocks and 2 output blocks.
+ */
+static int merge_sort_merge_runs(
+    MergeSortIO *io,
+    const MergeSortRunList *runs,
+    int first,
+    int k,
+    FILE *output,
+    fpos_t *output_position,
+    unsigned long *output_length,
+    int *memory,
+    int memory_count
+)
+{
+    MergeSortRunReader readers[CDSA_MERGE_SORT_MAX_FAN_IN];
+    int loser[CDSA_MERGE_SORT_MAX_FAN_IN];
+    int winners[2 * CDSA_MERGE_SORT_MAX_FAN_IN];
+    MergeSortIORequest write_request[2];
+    MergeSortRunReader *reader;
+    int *output_block[2];
+    int block_count = memory_count / (2 * k + 2);
+    int current = 0;
+    int filled = 0;
+    int pending = 0;
+    int rc = CDSA_MERGE_SORT_OK;
+    int i, winner, node, temp;
+    *output_length = 0;
+    for (i = 0; i < k; i++)
+    {
+        readers[i].position = runs->position[first + i];
+        readers[i].remaining = runs->length[first + i];
+        readers[i].block[0] = memory + (2 * i) * block_count;
+        readers[i].block[1] = memory + (2 * i + 1) * block_count;
+        readers[i].current = 0;
+        readers[i].index = 0;
+        readers[i].exhausted = 0;
+        merge_sort_refill_run(io, runs->file, &readers[i], 0, block_count);
+    }
+    for (i = 0; i < k; i++)
+    {
+        if (merge_sort_wait_io(io, &readers[i].request[0]) < 0)
+        {
+            rc = CDSA_MERGE_SORT_FAILED;
+        }
+        readers[i].exhausted = readers[i].request[0].count == 0;
+        if (readers[i].remaining > 0)
+        {
+            merge_sort_refill_run(io, runs->file, &readers[i], 1, block_count);
+        }
+        else
+        {
+            readers[i].request[1].count = 0;
+            readers[i].request[1].done = 1;
+            readers[i].request[1].failed = 0;
+        }
+    }
+    output_block[0] = memory + 2 * k * block_count;
+    output_block[1] = memory + (2 * k + 1) * block_count;
+    write_request[0].file = write_request[1].file = output;
+    write_request[0].position = write_request[1].position = NULL;
+    /* Nobody else writes to output at this point, so this is safe. */
+    if (output_position != NULL && fgetpos(output, output_position) != 0)
+    {
+        rc = CDSA_MERGE_SORT_FAILED;
+    }
+    /* Build the loser tree bottom-up; leaf i sits at position k + i. */
+    winners[1] = 0; /* Defensive initialization */
+    for (i = 0; i < k; i++) winners[k + i] = i;
+    for (node = k - 1; node >= 1; node--)
+    {
+        if (merge_sort_run_before(
+            readers,
+            winners[2 * node],
+            winners[2 * node + 1]
+        ))
+        {
+            winners[node] = winners[2 * node];
+            loser[node] = winners[2 * node + 1];
+        }
+        else
+        {
+            winners[node] = winners[2 * node + 1];
+            loser[node] = winners[2 * node];
+        }
+    }
+    winner = winners[1];
+    while (rc == CDSA_MERGE_SORT_OK && !readers[winner].exhausted)
+    {
+        reader = &readers[winner];
+        output_block[current][filled++] =
+            reader->block[reader->current][reader->index];
+        if (filled == block_count)
+        {
+            /* Hand the full block to the I/O thread and fill the other. */
+            if (
+                pending
+                && merge_sort_wait_io(io, &write_request[1 - current]) < 0
+            )
+            {
+                rc = CDSA_MERGE_SORT_FAILED;
+            }
+            write_request[current].data = output_block[current];
+            merge_sort_submit_io(io, &write_request[current], 1, filled);
+            *output_length += filled;
+            pending = 1;
+            current = 1 - current;
+            filled = 0;
+        }
+        if (merge_sort_advance_run(io, runs->file, reader, block_count))
+        {
+            rc = CDSA_MERGE_SORT_FAILED;
+        }
+        /* Replay the matches from the winner's leaf up to the root. */
+        for (node = (k + winner) / 2; node >= 1; node /= 2)
+        {
+            if (merge_sort_run_before(readers, loser[node], winner))
+            {
+                temp = loser[node];
+                loser[node] = winner;
+                winner = temp;
+            }
+        }
+    }
+    if (pending && merge_sort_wait_io(io, &write_request[1 - current]) < 0)
+    {
+        rc = CDSA_MERGE_SORT_FAILED;
+    }
+    if (filled > 0)
+    {
+        write_request[current].data = output_block[current];
+        merge_sort_submit_io(io, &write_request[current], 1, filled);
+        if (merge_sort_wait_io(io, &write_request[current]) < 0)
+        {
+            rc = CDSA_MERGE_SORT_FAILED;
+        }
+        *output_length += filled;
+    }
+    /* Drain the reads still in flight before the blocks are reused. */
+    for (i = 0; i < k; i++)
+    {
+        (void)merge_sort_wait_io(io, &readers[i].request[0]);
+        (void)merge_sort_wait_io(io, &readers[i].request[1]);
+    }
+    if (rc != CDSA_MERGE_SORT_OK)
+    {
+        fprintf(stderr, "External merge sort failed: failed to merge runs.\n");
+    }
+    return rc;
+}
+
+int merge_sort_external(
+    const char *input_path,
+    const char *output_path,
+    int memory_count
+)
+{
+    MergeSortIO io;
+    MergeSortRunList runs, merged;
+    FILE *input = NULL;
+    FILE *output = NULL;
+    int *memory = NULL;
+    fpos_t position;
+    unsigned long length;
+    int rc = CDSA_MERGE_SORT_OK;
+    int first, k;
+    if (input_path == NULL || output_path == NULL)
+    {
+        fprintf(
+            stderr,
+            "External merge sort failed: invalid parameter: "
+            "paths cannot be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (memory_count < CDSA_MERGE_SORT_EXTERNAL_MIN_MEMORY)
+    {
+        memory_count = CDSA_MERGE_SORT_EXTERNAL_MIN_MEMORY;
+    }
+    memset(&runs, 0, sizeof(runs));
+    memset(&merged, 0, sizeof(merged));
+    memory = malloc(memory_count * sizeof(int));
+    if (memory == NULL)
+    {
+        fprintf(stderr, "External merge sort failed: failed to allocate.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    if (merge_sort_start_io(&io) != 0)
+    {
+        fprintf(
+            stderr,
+            "External merge sort failed: failed to start I/O thread.\n"
+        );
+        free(memory);
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    input = fopen(input_path, "rb");
+    runs.file = tmpfile();
+    if (input == NULL || runs.file == NULL)
+    {
+        fprintf(stderr, "External merge sort failed: failed to open files.\n");
+        rc = CDSA_MERGE_SORT_FAILED;
+        goto cleanup_merge_sort_external;
+    }
+    rc = merge_sort_generate_runs(&io, input, &runs, memory, memory_count);
+    if (rc != CDSA_MERGE_SORT_OK) goto cleanup_merge_sort_external;
+    fclose(input);
+    input = NULL;
+    /* Merge groups of runs into longer runs until one pass can finish. */
+    while (runs.count > CDSA_MERGE_SORT_MAX_FAN_IN)
+    {
+        merged.file = tmpfile();
+        if (merged.file == NULL)
+        {
+            fprintf(
+                stderr,
+                "External merge sort failed: failed to open files.\n"
+            );
+            rc = CDSA_MERGE_SORT_FAILED;
+            goto cleanup_merge_sort_external;
+        }
+        for (first = 0; first < runs.count; first += k)
+        {
+            k = runs.count - first;
+            if (k > CDSA_MERGE_SORT_MAX_FAN_IN) k = CDSA_MERGE_SORT_MAX_FAN_IN;
+            rc = merge_sort_merge_runs(
+                &io,
+                &runs,
+                first,
+                k,
+                merged.file,
+                &position,
+                &length,
+                memory,
+                memory_count
+            );
+            if (rc == CDSA_MERGE_SORT_OK)
+            {
+                rc = merge_sort_push_run(&merged, &position, length);
+            }
+            if (rc != CDSA_MERGE_SORT_OK) goto cleanup_merge_sort_external;
+        }
+        merge_sort_clear_runs(&runs);
+        runs = merged;
+        memset(&merged, 0, sizeof(merged));
+    }
+    output = fopen(output_path, "wb");
+    if (output == NULL)
+    {
+        fprintf(stderr, "External merge sort failed: failed to open files.\n");
+        rc = CDSA_MERGE_SORT_FAILED;
+        goto cleanup_merge_sort_external;
+    }
+    if (runs.count > 0)
+    {
+        rc = merge_sort_merge_runs(
+            &io,
+            &runs,
+            0,
+            runs.count,
+            output,
+            NULL,
+            &length,
+            memory,
+            memory_count
+        );
+    }
+cleanup_merge_sort_external:
+    merge_sort_stop_io(&io);
+    if (output != NULL && fclose(output) != 0 && rc == CDSA_MERGE_SORT_OK)
+    {
+        fprintf(stderr, "External merge sort failed: failed to write.\n");
+        rc = CDSA_MERGE_SORT_FAILED;
+    }
+    if (input != NULL) fclose(input);
+    merge_sort_clear_runs(&runs);
+    merge_sort_clear_runs(&merged);
+    free(memory);
+    return rc;
+}
+
+static void merge_sort_generic_insertion(
+    const MergeSortGeneric *sort,
+    char *arr,
+    size_t left,
+    size_t right
+)
+{
+    size_t size = sort->size;
+    size_t i, j;
+    for (i = left + 1; i < right; i++)
+    {
+        j = i;
+        while (j > left
+            && sort->compare(arr + i * size, arr + (j - 1) * size) < 0)
+        {
+            j--;
+        }
+        if (j == i) continue;
+        /* Shift the whole block at once instead of one element per step */
+        memcpy(sort->spare, arr + i * size, size);
+        memmove(arr + (j + 1) * size, arr + j * size, (i - j) * size);
+        memcpy(arr + j * size, sort->spare, size);
+    }
+}
+
+static void merge_sort_generic_recursive(
+    const MergeSortGeneric *sort,
+    char *arr,
+    size_t left,
+    size_t right
+)
+{
+    size_t size = sort->size;
+    size_t middle, i, j, k;
+    if (right - left <= CDSA_MERGE_SORT_INSERTION_THRESHOLD)
+    {
+        merge_sort_generic_insertion(sort, arr, left, right);
+        return;
+    }
+    middle = left + (right - left) / 2;
+    merge_sort_generic_recursive(sort, arr, left, middle);
+    merge_sort_generic_recursive(sort, arr, middle, right);
+    if (sort->compare(arr + (middle - 1) * size, arr + middle * size) <= 0)
+    {
+        /* Both halves are already in order. */
+        return;
+    }
+    i = left;
+    j = middle;
+    k = left;
+    while (i < middle && j < right)
+    {
+        /* Equal elements are taken from the left half first (stable). */
+        if (sort->compare(arr + j * size, arr + i * size) < 0)
+        {
+            memcpy(sort->buffer + k++ * size, arr + j++ * size, size);
+        }
+        else
+        {
+            memcpy(sort->buffer + k++ * size, arr + i++ * size, size);
+        }
+    }
+    /* The rest of the right half is already in place. */
+    memcpy(sort->buffer + k * size, arr + i * size, (middle - i) * size);
+    memcpy(arr + left * size, sort->buffer + left * size, (j - left) * size);
+}
+
+int merge_sort_generic(
+    void *base,
+    size_t count,
+    size_t size,
+    int (*compare)(const void *, const void *)
+)
+{
+    MergeSortGeneric sort;
+    if (base == NULL || compare == NULL)
+    {
+        fprintf(
+            stderr,
+            "Merge sort failed: invalid parameter: base and compare cannot "
+            "be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (count < 2 || size == 0) return CDSA_MERGE_SORT_OK;
+    if (count > ((size_t)-1) / size - 1)
+    {
+        fprintf(stderr, "Merge sort failed: array is too large.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    sort.size = size;
+    sort.compare = compare;
+    sort.buffer = malloc((count + 1) * size);
+    if (sort.buffer == NULL)
+    {
+        fprintf(stderr, "Merge sort failed: failed to allocate buffer.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    sort.spare = sort.buffer + count * size;
+    merge_sort_generic_recursive(&sort, base, 0, count);
+    free(sort.buffer);
+    return CDSA_MERGE_SORT_OK;
+}
+
+static void merge_sort_pairs_insertion(
+    int *keys,
+    int *indices,
+    int left,
+    int right
+)
+{
+    int i, j, key, index;
+    for (i = left + 1; i < right; i++)
+    {
+        key = keys[i];
+        index = indices[i];
+        /* Strictly less: equal keys keep their order. */
+        for (j = i; j > left && key < keys[j - 1]; j--)
+        {
+            keys[j] = keys[j - 1];
+            indices[j] = indices[j - 1];
+        }
+        keys[j] = key;
+        indices[j] = index;
+    }
+}
+
+/* Merge the sorted src[left, middle) and src[middle, right) into dst, where
+ * every key moves together with its index. */
+static void merge_sort_pairs_merge_into(
+    const int *src_keys,
+    const int *src_indices,
+    int *dst_keys,
+    int *dst_indices,
+    int left,
+    int middle,
+    int right
+)
+{
+    int i = left, j = middle, k = left;
+    int source, take_right;
+    while (i < middle && j < right)
+    {
+        /* Right half only when strictly less (stable). Selecting the
+         * position rather than the values keeps both loads unconditional,
+         * so this compiles to a conditional move instead of a branch. */
+        take_right = src_keys[j] < src_keys[i];
+        source = take_right ? j : i;
+        dst_keys[k] = src_keys[source];
+        dst_indices[k++] = src_indices[source];
+        i += !take_right;
+        j += take_right;
+    }
+    while (i < middle)
+    {
+        dst_keys[k] = src_keys[i];
+        dst_indices[k++] = src_indices[i++];
+    }
+    while (j < right)
+    {
+        dst_keys[k] = src_keys[j];
+        dst_indices[k++] = src_indices[j++];
+    }
+}
+
+/* Stably sort keys together with indices, bottom-up as in
+ * merge_sort_bottom_up(). The buffers hold arr_count ints each. */
+static void merge_sort_pairs(
+    int arr_count,
+    int *keys,
+    int *indices,
+    int *key_buffer,
+    int *index_buffer
+)
+{
+    int *src_keys = keys, *src_indices = indices;
+    int *dst_keys = key_buffer, *dst_indices = index_buffer;
+    int *temp;
+    int width, left, middle, right;
+    width = CDSA_MERGE_SORT_INSERTION_THRESHOLD;
+    for (left = 0; left < arr_count; left = right)
+    {
+        right = (width < arr_count - left) ? left + width : arr_count;
+        merge_sort_pairs_insertion(keys, indices, left, right);
+    }
+    for (; width < arr_count; width *= 2)
+    {
+        for (left = 0; left < arr_count; left = right)
+        {
+            middle = (width < arr_count - left) ? left + width : arr_count;
+            right = (width < arr_count - middle) ? middle + width : arr_count;
+            if (middle == right || src_keys[middle - 1] <= src_keys[middle])
+            {
+                /* Already in order, only copied to the other side. */
+                memcpy(
+                    dst_keys + left,
+                    src_keys + left,
+                    (right - left) * sizeof(int)
+                );
+                memcpy(
+                    dst_indices + left,
+                    src_indices + left,
+                    (right - left) * sizeof(int)
+                );
+                continue;
+            }
+            merge_sort_pairs_merge_into(
+                src_keys,
+                src_indices,
+                dst_keys,
+                dst_indices,
+                left,
+                middle,
+                right
+            );
+        }
+        temp = src_keys;
+        src_keys = dst_keys;
+        dst_keys = temp;
+        temp = src_indices;
+        src_indices = dst_indices;
+        dst_indices = temp;
+    }
+    if (src_keys != keys)
+    {
+        memcpy(keys, src_keys, arr_count * sizeof(int));
+        memcpy(indices, src_indices, arr_count * sizeof(int));
+    }
+}
+
+int merge_sort_argsort(int arr_count, const int *keys, int *indices)
+{
+    int *memory;
+    int i;
+    if (keys == NULL || indices == NULL)
+    {
+        fprintf(
+            stderr,
+            "Argsort failed: invalid parameter: keys and indices cannot be "
+            "NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    for (i = 0; i < arr_count; i++)
+    {
+        indices[i] = i;
+    }
+    if (arr_count < 2) return CDSA_MERGE_SORT_OK;
+    if ((size_t)arr_count > ((size_t)-1) / (3 * sizeof(int)))
+    {
+        fprintf(stderr, "Argsort failed: array is too large.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    /* A copy of the keys, sorted alongside, and one buffer for each. */
+    memory = malloc(3 * (size_t)arr_count * sizeof(int));
+    if (memory == NULL)
+    {
+        fprintf(stderr, "Argsort failed: failed to allocate buffer.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    memcpy(memory, keys, arr_count * sizeof(int));
+    merge_sort_pairs(
+        arr_count,
+        memory,
+        indices,
+        memory + arr_count,
+        memory + 2 * arr_count
+    );
+    free(memory);
+    return CDSA_MERGE_SORT_OK;
+}
+
+int merge_sort_by_key(
+    int arr_count,
+    int *keys,
+    void *payload,
+    size_t payload_size
+)
+{
+    char *records = payload;
+    char *spare;
+    int *indices;
+    int i, j, k;
+    if (keys == NULL || payload == NULL)
+    {
+        fprintf(
+            stderr,
+            "Merge sort failed: invalid parameter: keys and payload cannot "
+            "be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_MERGE_SORT_OK;
+    if ((size_t)arr_count
+        > (((size_t)-1) - payload_size) / (3 * sizeof(int)))
+    {
+        fprintf(stderr, "Merge sort failed: array is too large.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    /* The permutation, one buffer for the keys and one for the permutation,
+     * then room for one payload element. */
+    indices = malloc(3 * (size_t)arr_count * sizeof(int) + payload_size);
+    if (indices == NULL)
+    {
+        fprintf(stderr, "Merge sort failed: failed to allocate buffer.\n");
+        return CDSA_MERGE_SORT_ALLOC_FAILED;
+    }
+    spare = (char *)(indices + 3 * arr_count);
+    for (i = 0; i < arr_count; i++)
+    {
+        indices[i] = i;
+    }
+    merge_sort_pairs(
+        arr_count,
+        keys,
+        indices,
+        indices + arr_count,
+        indices + 2 * arr_count
+    );
+    /* Slot i now takes the payload of slot indices[i]. Follow each cycle of
+     * the permutation, so every element is copied once and no payload-sized
+     * buffer is needed. Done slots are marked by indices[j] == j. */
+    for (i = 0; payload_size > 0 && i < arr_count; i++)
+    {
+        if (indices[i] == i) continue;
+        memcpy(spare, records + i * payload_size, payload_size);
+        for (j = i; indices[j] != i; j = k)
+        {
+            k = indices[j];
+            memcpy(
+                records + j * payload_size,
+                records + k * payload_size,
+                payload_size
+            );
+            indices[j] = j;
+        }
+        memcpy(records + j * payload_size, spare, payload_size);
+        indices[j] = j;
+    }
+    free(indices);
+    return CDSA_MERGE_SORT_OK;
+}
+
+/* Whether the next element of run x goes before the one of run y. */
+static int merge_sort_stream_before(
+    const MergeSortStream *stream,
+    int x,
+    int y
+)
+{
+    int a, b;
+    if (stream->cursor[x] == stream->run_end[x]) return 0;
+    if (stream->cursor[y] == stream->run_end[y]) return 1;
+    a = stream->data[stream->cursor[x]];
+    b = stream->data[stream->cursor[y]];
+    return a < b || (a == b && x < y);
+}
+
+MergeSortStream *new_merge_sort_stream()
+{
+    MergeSortStream *stream = malloc(sizeof(MergeSortStream));
+    if (stream == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to create new merge sort stream: failed to allocate.\n"
+        );
+        return NULL;
+    }
+    stream->data = NULL;
+    stream->buffer = NULL;
+    stream->count = 0;
+    stream->capacity = 0;
+    stream->run_count = 0;
+    stream->finished = 0;
+    stream->winner = 0;
+    return stream;
+}
+
+int merge_sort_stream_feed(
+    MergeSortStream *stream,
+    int batch_count,
+    const int *batch
+)
+{
+    int *data, *buffer;
+    int capacity, top;
+    if (stream == NULL || (batch == NULL && batch_count > 0))
+    {
+        fprintf(
+            stderr,
+            "Failed to feed merge sort stream: invalid parameter: "
+            "stream and batch cannot be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (stream->finished)
+    {
+        fprintf(
+            stderr,
+            "Failed to feed merge sort stream: stream is finished.\n"
+        );
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    if (batch_count <= 0) return CDSA_MERGE_SORT_OK;
+    if (batch_count > INT_MAX - stream->count)
+    {
+        fprintf(stderr, "Failed to feed merge sort stream: too many ints.\n");
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    if (stream->count + batch_count > stream->capacity)
+    {
+        /* Grow geometrically, as merge_sort_with_context() does. */
+        capacity = (stream->capacity <= INT_MAX / 2)
+            ? 2 * stream->capacity
+            : INT_MAX;
+        if (capacity < stream->count + batch_count)
+        {
+            capacity = stream->count + batch_count;
+        }
+        data = realloc(stream->data, capacity * sizeof(int));
+        if (data == NULL) goto cleanup_merge_sort_stream_feed_alloc_failed;
+        stream->data = data;
+        /* The buffer holds no data between calls, no need to copy it. */
+        buffer = malloc(capacity * sizeof(int));
+        if (buffer == NULL) goto cleanup_merge_sort_stream_feed_alloc_failed;
+        free(stream->buffer);
+        stream->buffer = buffer;
+        stream->capacity = capacity;
+    }
+    data = stream->data + stream->count;
+    memcpy(data, batch, batch_count * sizeof(int));
+    merge_sort_with_buffer(batch_count, data, stream->buffer);
+    top = stream->run_count;
+    stream->run_start[top] = stream->count;
+    stream->run_end[top] = stream->count + batch_count;
+    stream->count += batch_count;
+    /*
+     * Merge the new run into the previous one while that one is less than
+     * twice as long: run lengths at least double toward the bottom, so each
+     * element takes part in O(log n) merges and fewer than 32 runs remain.
+     */
+    while (
+        top > 0
+        && stream->run_end[top - 1] - stream->run_start[top - 1]
+            - (stream->run_end[top] - stream->run_start[top])
+            < stream->run_end[top] - stream->run_start[top]
+    )
+    {
+        if (stream->data[stream->run_start[top] - 1]
+            > stream->data[stream->run_start[top]])
+        {
+            merge_sort_merge(
+                stream->data,
+                stream->run_start[top - 1],
+                stream->run_start[top],
+                stream->run_end[top],
+                stream->buffer
+            );
+        }
+        stream->run_end[top - 1] = stream->run_end[top];
+        top -= 1;
+    }
+    stream->run_count = top + 1;
+    return CDSA_MERGE_SORT_OK;
+cleanup_merge_sort_stream_feed_alloc_failed:
+    fprintf(
+        stderr,
+        "Failed to feed merge sort stream: failed to allocate memory.\n"
+    );
+    return CDSA_MERGE_SORT_ALLOC_FAILED;
+}
+
+int merge_sort_stream_finish(MergeSortStream *stream)
+{
+    int winners[2 * CDSA_MERGE_SORT_MAX_RUNS];
+    int k, i, node;
+    if (stream == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to finish merge sort stream: stream is NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (stream->finished) return CDSA_MERGE_SORT_OK;
+    stream->finished = 1;
+    /* The data is final, so the scratch buffer can go. */
+    free(stream->buffer);
+    stream->buffer = NULL;
+    k = stream->run_count;
+    if (k == 0) return CDSA_MERGE_SORT_OK;
+    for (i = 0; i < k; i++) stream->cursor[i] = stream->run_start[i];
+    /* Build the loser tree bottom-up; leaf i sits at position k + i. */
+    winners[1] = 0; /* Defensive initialization */
+    for (i = 0; i < k; i++) winners[k + i] = i;
+    for (node = k - 1; node >= 1; node--)
+    {
+        if (merge_sort_stream_before(
+            stream,
+            winners[2 * node],
+            winners[2 * node + 1]
+        ))
+        {
+            winners[node] = winners[2 * node];
+            stream->loser[node] = winners[2 * node + 1];
+        }
+        else
+        {
+            winners[node] = winners[2 * node + 1];
+            stream->loser[node] = winners[2 * node];
+        }
+    }
+    stream->winner = winners[1];
+    return CDSA_MERGE_SORT_OK;
+}
+
+int merge_sort_stream_next_sorted(MergeSortStream *stream, int *data_ref)
+{
+    int k, winner, node, temp;
+    if (stream == NULL || data_ref == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to pull from merge sort stream: invalid parameter: "
+            "stream and data_ref cannot be NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (!stream->finished)
+    {
+        fprintf(
+            stderr,
+            "Failed to pull from merge sort stream: stream is not finished.\n"
+        );
+        return CDSA_MERGE_SORT_FAILED;
+    }
+    k = stream->run_count;
+    winner = stream->winner;
+    if (k == 0 || stream->cursor[winner] == stream->run_end[winner])
+    {
+        return CDSA_MERGE_SORT_EMPTY;
+    }
+    *data_ref = stream->data[stream->cursor[winner]++];
+    /* Replay the matches from the winner's leaf up to the root. */
+    for (node = (k + winner) / 2; node >= 1; node /= 2)
+    {
+        if (merge_sort_stream_before(stream, stream->loser[node], winner))
+        {
+            temp = stream->loser[node];
+            stream->loser[node] = winner;
+            winner = temp;
+        }
+    }
+    stream->winner = winner;
+    return CDSA_MERGE_SORT_OK;
+}
+
+int destroy_merge_sort_stream(MergeSortStream **stream_ref)
+{
+    if (stream_ref == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to destroy merge sort stream: "
+            "stream reference is NULL.\n"
+        );
+        return CDSA_MERGE_SORT_NULL;
+    }
+    if (*stream_ref == NULL)
+    {
+        return CDSA_MERGE_SORT_OK;
+    }
+    free((*stream_ref)->data);
+    free((*stream_ref)->buffer);
+    free(*stream_ref);
+    *stream_ref = NULL;
+    return CDSA_MERGE_SORT_OK;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file partial_sort.c
+ * @author HN Thap
+ * @brief Partial sort (top-k) and selection for int arrays.
+ * 
+ * partial_sort() leaves the k smallest elements, sorted, in arr[0, k) and
+ * the other ones in arr[k, arr_count), in no particular order. When k is
+ * small next to the array (at most arr_count / CDSA_PARTIAL_SORT_HEAP_RATIO
+ * elements), it keeps the k smallest elements seen so far in a bounded
+ * max-heap at the front of the array: each further element costs a single
+ * comparison with the root, and O(log k) moves only when it is smaller, so
+ * the whole sort is O(n log k). Otherwise, partial_sort_nth_element() splits
+ * the array around arr[k - 1] first, in O(n), and only arr[0, k) is sorted,
+ * by an introsort built on the same partition.
+ * 
+ * partial_sort_nth_element() is an introselect: a quickselect on a
+ * median-of-three pivot, which only recurses (iteratively) into the side
+ * holding the requested position. If partitioning goes wrong too many times
+ * (more than twice the bit length of the array size), the rest is finished
+ * with the bounded heap instead, so the worst case stays O(n log n).
+ * 
+ * Nothing is allocated: both functions work in-place with O(1) extra space.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "partial_sort.h"
+
+/**
+ * @brief Ranges of this many elements or fewer are insertion-sorted instead
+ * of partitioned.
+ */
+#define CDSA_PARTIAL_SORT_INSERTION_THRESHOLD (16)
+
+/**
+ * @brief partial_sort() uses the bounded heap when k is at most
+ * arr_count / CDSA_PARTIAL_SORT_HEAP_RATIO, and selection otherwise.
+ */
+#define CDSA_PARTIAL_SORT_HEAP_RATIO (128)
+
+/**
+ * @brief Split arr[left, right), at least 2 elements long, around a
+ * median-of-three pivot.
+ * 
+ * @return int Position j in [left, right - 1) such that
+ * arr[left, j] <= pivot <= arr[j + 1, right)
+ */
+static int partial_sort_partition(int *arr, int left, int right);
+
+/**
+ * @brief Sort an array in-place with quicksort, falling back to heap sort
+ * when depth_limit bad partitions have been made.
+ */
+static void partial_sort_introsort(int *arr, int count, int depth_limit);
+
+/**
+ * @brief Move the k smallest elements of arr[0, arr_count) into a max-heap in
+ * arr[0, k), the largest of them at arr[0].
+ */
+static void partial_sort_heap_select(int arr_count, int *arr, int k);
+
+/**
+ * @brief Sort a max-heap of count elements in-place, in ascending order.
+ */
+static void partial_sort_heap_sort(int count, int *arr);
+
+/**
+ * @brief Restore the max-heap property of arr[0, count) below position
+ * index, whose key is replaced by key.
+ */
+static void partial_sort_sift_down(int *arr, int count, int index, int key);
+
+/**
+ * @brief Insertion sort for short ranges.
+ */
+static void partial_sort_insertion(int *arr, int count);
+
+/**
+ * @brief Swap arr[i] and arr[j].
+ */
+static void partial_sort_swap(int *arr, int i, int j);
+
+void partial_sort(int arr_count, int *arr, int k)
+{
+    int depth_limit = 0;
+    int i;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (k > arr_count) k = arr_count;
+    if (k <= 0) return;
+    if (k <= arr_count / CDSA_PARTIAL_SORT_HEAP_RATIO)
+    {
+        partial_sort_heap_select(arr_count, arr, k);
+        partial_sort_heap_sort(k, arr);
+        return;
+    }
+    if (k < arr_count)
+    {
+        /* arr[k - 1] is then in place, and only arr[0, k - 1) is left. */
+        partial_sort_nth_element(arr_count, arr, k - 1);
+        k -= 1;
+    }
+    for (i = k; i > 0; i /= 2) depth_limit += 2;
+    partial_sort_introsort(arr, k, depth_limit);
+}
+
+void partial_sort_nth_element(int arr_count, int *arr, int nth)
+{
+    int left = 0;
+    int right = arr_count;
+    int depth_limit = 0;
+    int i, j;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (nth < 0 || nth >= arr_count)
+    {
+        fprintf(stderr, "Invalid parameter: nth is out of range.\n");
+        return;
+    }
+    for (i = arr_count; i > 0; i /= 2) depth_limit += 2;
+    while (right - left > CDSA_PARTIAL_SORT_INSERTION_THRESHOLD)
+    {
+        if (depth_limit-- == 0)
+        {
+            /* Too many bad pivots: finish with the bounded heap. */
+            partial_sort_heap_select(right - left, arr + left, nth - left + 1);
+            partial_sort_swap(arr, left, nth);
+            return;
+        }
+        j = partial_sort_partition(arr, left, right);
+        if (nth <= j)
+        {
+            right = j + 1;
+        }
+        else
+        {
+            left = j + 1;
+        }
+    }
+    partial_sort_insertion(arr + left, right - left);
+}
+
+static int partial_sort_partition(int *arr, int left, int right)
+{
+    int middle = left + (right - left) / 2;
+    int i = left - 1;
+    int j = right;
+    int pivot;
+    /* Median of three, moved to arr[left] so that the split is proper. */
+    if (arr[middle] < arr[left]) partial_sort_swap(arr, middle, left);
+    if (arr[right - 1] < arr[middle])
+    {
+        partial_sort_swap(arr, right - 1, middle);
+        if (arr[middle] < arr[left]) partial_sort_swap(arr, middle, left);
+    }
+    partial_sort_swap(arr, middle, left);
+    pivot = arr[left];
+    /*
+     * Hoare partition: both scans stop on keys equal to the pivot, so runs
+     * of equal keys are split evenly instead of degrading.
+     */
+    while (1) /* Loop termination is warranteed. */
+    {
+        do
+        {
+            i++;
+        } while (arr[i] < pivot);
+        do
+        {
+            j--;
+        } while (pivot < arr[j]);
+        if (i >= j) return j;
+        partial_sort_swap(arr, i, j);
+    }
+}
+
+static void partial_sort_introsort(int *arr, int count, int depth_limit)
+{
+    int j;
+    while (count > CDSA_PARTIAL_SORT_INSERTION_THRESHOLD)
+    {
+        if (depth_limit-- == 0)
+        {
+            partial_sort_heap_select(count, arr, count);
+            partial_sort_heap_sort(count, arr);
+            return;
+        }
+        j = partial_sort_partition(arr, 0, count);
+        /* Recurse into the smaller side only, to bound the stack depth. */
+        if (j + 1 < count - j - 1)
+        {
+            partial_sort_introsort(arr, j + 1, depth_limit);
+            arr += j + 1;
+            count -= j + 1;
+        }
+        else
+        {
+            partial_sort_introsort(arr + j + 1, count - j - 1, depth_limit);
+            count = j + 1;
+        }
+    }
+    partial_sort_insertion(arr, count);
+}
+
+static void partial_sort_heap_select(int arr_count, int *arr, int k)
+{
+    int i, key;
+    for (i = k / 2 - 1; i >= 0; i--)
+    {
+        partial_sort_sift_down(arr, k, i, arr[i]);
+    }
+    for (i = k; i < arr_count; i++)
+    {
+        if (arr[i] < arr[0])
+        {
+            key = arr[i];
+            arr[i] = arr[0];
+            partial_sort_sift_down(arr, k, 0, key);
+        }
+    }
+}
+
+static void partial_sort_heap_sort(int count, int *arr)
+{
+    int i, key;
+    for (i = count - 1; i > 0; i--)
+    {
+        key = arr[i];
+        arr[i] = arr[0];
+        partial_sort_sift_down(arr, i, 0, key);
+    }
+}
+
+static void partial_sort_sift_down(int *arr, int count, int index, int key)
+{
+    int child;
+    /* Move the hole down instead of swapping, one write per level. */
+    while ((child = 2 * index + 1) < count)
+    {
+        if (child + 1 < count && arr[child] < arr[child + 1]) child++;
+        if (!(key < arr[child])) break;
+        arr[index] = arr[child];
+        index = child;
+    }
+    arr[index] = key;
+}
+
+static void partial_sort_insertion(int *arr, int count)
+{
+    int i, j, key;
+    for (i = 1; i < count; i++)
+    {
+        key = arr[i];
+        for (j = i; j > 0 && arr[j - 1] > key; j--)
+        {
+            arr[j] = arr[j - 1];
+        }
+        arr[j] = key;
+    }
+}
+
+static void partial_sort_swap(int *arr, int i, int j)
+{
+    int temp = arr[i];
+    arr[i] = arr[j];
+    arr[j] = temp;
+}
@@ -0,0 +1,478 @@
+/**
+ * @file radix_sort.c
+ * @author HN Thap
+ * @brief Radix sort and counting sort for int keys.
+ * 
+ * radix_sort() is an LSD radix sort on CDSA_RADIX_SORT_DIGIT_BITS-bit
+ * digits. The sign bit of every key is flipped, so that negative values come
+ * first when keys are compared as unsigned. One pass over the input computes
+ * the histograms of all digits at once, then each digit costs a single
+ * scatter pass between the array and a buffer. Digits above the highest bit
+ * in which the smallest and largest keys differ are never scattered, and
+ * neither is any digit that all keys share.
+ * 
+ * When the values span a small range (CDSA_RADIX_SORT_COUNTING_MAX_RANGE
+ * values at most, and no more than the number of elements), radix_sort()
+ * switches to radix_sort_counting(), which only counts each value and writes
+ * the counts back, without any buffer.
+ * 
+ * radix_sort_parallel() is an MSD variant for multi-core machines (POSIX
+ * threads). The threads histogram and scatter their own slices of the input
+ * by the most significant digit in which keys differ, then take whole
+ * buckets one at a time and finish each with the LSD sort above. No bucket
+ * is shared between threads, so there is no synchronization besides taking
+ * the next bucket.
+ * 
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ */
+
+/* Needed for POSIX threads under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radix_sort.h"
+
+/**
+ * @brief Number of bits per radix digit.
+ */
+#define CDSA_RADIX_SORT_DIGIT_BITS (8)
+
+/**
+ * @brief Number of distinct digit values (buckets per pass).
+ */
+#define CDSA_RADIX_SORT_BUCKETS (1 << CDSA_RADIX_SORT_DIGIT_BITS)
+
+/**
+ * @brief Number of digits in an int key.
+ */
+#define CDSA_RADIX_SORT_DIGITS \
+    ((int)(sizeof(int) * CHAR_BIT / CDSA_RADIX_SORT_DIGIT_BITS))
+
+/**
+ * @brief The sign bit of an int, as an unsigned int.
+ */
+#define CDSA_RADIX_SORT_SIGN_BIT ((unsigned int)INT_MAX + 1u)
+
+/**
+ * @brief Map an int to an unsigned key with the same order.
+ */
+#define CDSA_RADIX_SORT_KEY(x) \
+    ((unsigned int)(x) ^ CDSA_RADIX_SORT_SIGN_BIT)
+
+/**
+ * @brief Ranges of this many elements or fewer are insertion-sorted instead
+ * of scattered.
+ */
+#define CDSA_RADIX_SORT_INSERTION_THRESHOLD (64)
+
+/**
+ * @brief State shared by all threads of radix_sort_parallel().
+ */
+typedef struct RadixSortShared
+{
+    int *arr;
+    int *buffer;
+    int shift; /* Position of the lowest bit of the MSD digit */
+    int digits; /* Number of LSD digits below the MSD digit */
+    int bucket_start[CDSA_RADIX_SORT_BUCKETS + 1];
+    int next_bucket;
+    pthread_mutex_t lock;
+} RadixSortShared;
+
+/**
+ * @brief One thread of radix_sort_parallel() with its slice of the input.
+ */
+typedef struct RadixSortWorker
+{
+    RadixSortShared *shared;
+    int begin;
+    int end;
+    unsigned int min_key;
+    unsigned int max_key;
+    int offsets[CDSA_RADIX_SORT_BUCKETS];
+} RadixSortWorker;
+
+/**
+ * @brief Sort src by its lowest digits, using dst as the scatter target.
+ * 
+ * @param src Array to sort
+ * @param dst Buffer of the same size
+ * @param count Size of both arrays
+ * @param digits Number of digits to sort by, starting from the lowest one;
+ * keys must be equal above them
+ * @return int* src or dst, whichever holds the sorted keys
+ */
+static int *radix_sort_lsd(int *src, int *dst, int count, int digits);
+
+/**
+ * @brief Number of digits from the lowest one up to the highest bit set in
+ * diff (0 when diff is 0).
+ */
+static int radix_sort_digits_of(unsigned int diff);
+
+/**
+ * @brief Insertion sort for short ranges.
+ */
+static void radix_sort_insertion(int *arr, int count);
+
+void radix_sort(int arr_count, int *arr)
+{
+    int *buffer;
+    int *sorted;
+    int min_value, max_value, i;
+    unsigned int span;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (arr_count <= CDSA_RADIX_SORT_INSERTION_THRESHOLD)
+    {
+        radix_sort_insertion(arr, arr_count);
+        return;
+    }
+    min_value = max_value = arr[0];
+    for (i = 1; i < arr_count; i++)
+    {
+        if (arr[i] < min_value) min_value = arr[i];
+        if (arr[i] > max_value) max_value = arr[i];
+    }
+    span = (unsigned int)max_value - (unsigned int)min_value;
+    if (span < (unsigned int)arr_count
+        && span < CDSA_RADIX_SORT_COUNTING_MAX_RANGE)
+    {
+        radix_sort_counting(arr_count, arr, min_value, max_value);
+        return;
+    }
+    buffer = malloc(arr_count * sizeof(int));
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    sorted = radix_sort_lsd(
+        arr,
+        buffer,
+        arr_count,
+        radix_sort_digits_of(
+            CDSA_RADIX_SORT_KEY(min_value) ^ CDSA_RADIX_SORT_KEY(max_value)
+        )
+    );
+    if (sorted != arr) memcpy(arr, sorted, arr_count * sizeof(int));
+    free(buffer);
+}
+
+void radix_sort_counting(int arr_count, int *arr, int min_value, int max_value)
+{
+    int *counts;
+    unsigned int span, value;
+    int i, j;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (arr_count < 2 || min_value >= max_value) return;
+    span = (unsigned int)max_value - (unsigned int)min_value;
+    if (span >= CDSA_RADIX_SORT_COUNTING_MAX_RANGE)
+    {
+        radix_sort(arr_count, arr);
+        return;
+    }
+    counts = calloc(span + 1, sizeof(int));
+    if (counts == NULL)
+    {
+        fprintf(stderr, "Failed to allocate counts. Exiting.\n");
+        exit(1);
+    }
+    for (i = 0; i < arr_count; i++)
+    {
+        counts[(unsigned int)arr[i] - (unsigned int)min_value] += 1;
+    }
+    i = 0;
+    for (value = 0; value <= span; value++)
+    {
+        for (j = counts[value]; j > 0; j--)
+        {
+            arr[i++] = min_value + (int)value;
+        }
+    }
+    free(counts);
+}
+
+static void radix_sort_insertion(int *arr, int count)
+{
+    int i, j, value;
+    for (i = 1; i < count; i++)
+    {
+        value = arr[i];
+        for (j = i; j > 0 && arr[j - 1] > value; j--)
+        {
+            arr[j] = arr[j - 1];
+        }
+        arr[j] = value;
+    }
+}
+
+static int radix_sort_digits_of(unsigned int diff)
+{
+    int digits = 0;
+    while (diff != 0)
+    {
+        digits += 1;
+        diff >>= CDSA_RADIX_SORT_DIGIT_BITS;
+    }
+    return digits;
+}
+
+static int *radix_sort_lsd(int *src, int *dst, int count, int digits)
+{
+    int counts[CDSA_RADIX_SORT_DIGITS][CDSA_RADIX_SORT_BUCKETS];
+    int *swap;
+    int d, b, i, shift, sum, next;
+    unsigned int key;
+    if (count <= CDSA_RADIX_SORT_INSERTION_THRESHOLD)
+    {
+        radix_sort_insertion(src, count);
+        return src;
+    }
+    memset(counts, 0, sizeof(counts));
+    /* All histograms in a single pass over the keys */
+    for (i = 0; i < count; i++)
+    {
+        key = CDSA_RADIX_SORT_KEY(src[i]);
+        for (d = 0; d < digits; d++)
+        {
+            counts[d][key & (CDSA_RADIX_SORT_BUCKETS - 1)] += 1;
+            key >>= CDSA_RADIX_SORT_DIGIT_BITS;
+        }
+    }
+    for (d = 0; d < digits; d++)
+    {
+        shift = d * CDSA_RADIX_SORT_DIGIT_BITS;
+        key = CDSA_RADIX_SORT_KEY(src[0]) >> shift;
+        if (counts[d][key & (CDSA_RADIX_SORT_BUCKETS - 1)] == count)
+        {
+            continue; /* Every key has the same digit here */
+        }
+        sum = 0;
+        for (b = 0; b < CDSA_RADIX_SORT_BUCKETS; b++)
+        {
+            next = sum + counts[d][b];
+            counts[d][b] = sum;
+            sum = next;
+        }
+        for (i = 0; i < count; i++)
+        {
+            key = CDSA_RADIX_SORT_KEY(src[i]) >> shift;
+            dst[counts[d][key & (CDSA_RADIX_SORT_BUCKETS - 1)]++] = src[i];
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    return src;
+}
+
+/**
+ * @brief Run one phase of radix_sort_parallel(): routine runs once per
+ * worker, worker 0 on the calling thread. A worker whose thread fails to
+ * start is run on the calling thread afterwards, so every slice is covered.
+ */
+static void radix_sort_run_workers(
+    RadixSortWorker *workers,
+    int num_workers,
+    void *(*routine)(void *)
+)
+{
+    pthread_t threads[CDSA_RADIX_SORT_MAX_THREADS];
+    unsigned char started[CDSA_RADIX_SORT_MAX_THREADS];
+    int i;
+    for (i = 1; i < num_workers; i++)
+    {
+        started[i] = pthread_create(
+            &threads[i],
+            NULL,
+            routine,
+            &workers[i]
+        ) == 0;
+    }
+    (void)routine(&workers[0]);
+    for (i = 1; i < num_workers; i++)
+    {
+        if (started[i])
+        {
+            (void)pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            (void)routine(&workers[i]);
+        }
+    }
+}
+
+static void *radix_sort_parallel_scan(void *arg)
+{
+    RadixSortWorker *worker = arg;
+    const int *arr = worker->shared->arr;
+    unsigned int key;
+    int i;
+    worker->min_key = CDSA_RADIX_SORT_KEY(arr[worker->begin]);
+    worker->max_key = worker->min_key;
+    for (i = worker->begin + 1; i < worker->end; i++)
+    {
+        key = CDSA_RADIX_SORT_KEY(arr[i]);
+        if (key < worker->min_key) worker->min_key = key;
+        if (key > worker->max_key) worker->max_key = key;
+    }
+    return NULL;
+}
+
+static void *radix_sort_parallel_count(void *arg)
+{
+    RadixSortWorker *worker = arg;
+    const int *arr = worker->shared->arr;
+    int shift = worker->shared->shift;
+    int i;
+    memset(worker->offsets, 0, sizeof(worker->offsets));
+    for (i = worker->begin; i < worker->end; i++)
+    {
+        worker->offsets[
+            (CDSA_RADIX_SORT_KEY(arr[i]) >> shift)
+            & (CDSA_RADIX_SORT_BUCKETS - 1)
+        ] += 1;
+    }
+    return NULL;
+}
+
+static void *radix_sort_parallel_scatter(void *arg)
+{
+    RadixSortWorker *worker = arg;
+    const int *arr = worker->shared->arr;
+    int *buffer = worker->shared->buffer;
+    int shift = worker->shared->shift;
+    int i;
+    for (i = worker->begin; i < worker->end; i++)
+    {
+        buffer[worker->offsets[
+            (CDSA_RADIX_SORT_KEY(arr[i]) >> shift)
+            & (CDSA_RADIX_SORT_BUCKETS - 1)
+        ]++] = arr[i];
+    }
+    return NULL;
+}
+
+static void *radix_sort_parallel_buckets(void *arg)
+{
+    RadixSortWorker *worker = arg;
+    RadixSortShared *shared = worker->shared;
+    int *sorted;
+    int bucket, begin, count;
+    while (1) /* Loop termination is warranteed: buckets run out. */
+    {
+        pthread_mutex_lock(&shared->lock);
+        bucket = shared->next_bucket++;
+        pthread_mutex_unlock(&shared->lock);
+        if (bucket >= CDSA_RADIX_SORT_BUCKETS) break;
+        begin = shared->bucket_start[bucket];
+        count = shared->bucket_start[bucket + 1] - begin;
+        if (count == 0) continue;
+        /* The bucket sits in the buffer, and its slice of arr is free */
+        sorted = radix_sort_lsd(
+            shared->buffer + begin,
+            shared->arr + begin,
+            count,
+            shared->digits
+        );
+        if (sorted != shared->arr + begin)
+        {
+            memcpy(shared->arr + begin, sorted, count * sizeof(int));
+        }
+    }
+    return NULL;
+}
+
+void radix_sort_parallel(int arr_count, int *arr, int num_threads)
+{
+    RadixSortShared shared;
+    RadixSortWorker *workers;
+    unsigned int min_key, max_key;
+    int i, b, sum, count, high_bit;
+    if (arr == NULL)
+    {
+        fprintf(stderr, "Invalid parameter: arr cannot be NULL.\n");
+        return;
+    }
+    if (num_threads > CDSA_RADIX_SORT_MAX_THREADS)
+    {
+        num_threads = CDSA_RADIX_SORT_MAX_THREADS;
+    }
+    if (num_threads <= 1 || arr_count <= CDSA_RADIX_SORT_PARALLEL_GRAIN)
+    {
+        radix_sort(arr_count, arr);
+        return;
+    }
+    shared.arr = arr;
+    shared.buffer = malloc(arr_count * sizeof(int));
+    workers = malloc(num_threads * sizeof(RadixSortWorker));
+    if (shared.buffer == NULL || workers == NULL)
+    {
+        fprintf(stderr, "Failed to allocate buffer. Exiting.\n");
+        exit(1);
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        workers[i].shared = &shared;
+        workers[i].begin = (int)((double)arr_count * i / num_threads);
+        workers[i].end = (int)((double)arr_count * (i + 1) / num_threads);
+    }
+    radix_sort_run_workers(workers, num_threads, radix_sort_parallel_scan);
+    min_key = workers[0].min_key;
+    max_key = workers[0].max_key;
+    for (i = 1; i < num_threads; i++)
+    {
+        if (workers[i].min_key < min_key) min_key = workers[i].min_key;
+        if (workers[i].max_key > max_key) max_key = workers[i].max_key;
+    }
+    if (min_key == max_key) goto cleanup_radix_sort_parallel;
+    /*
+     * Bits above the highest one in which the extreme keys differ are the
+     * same in every key, so the MSD digit ends at that bit. Keys within a
+     * bucket then differ only below the digit.
+     */
+    high_bit = 0;
+    while ((min_key ^ max_key) >> high_bit > 1u) high_bit += 1;
+    shared.shift = high_bit + 1 - CDSA_RADIX_SORT_DIGIT_BITS;
+    if (shared.shift < 0) shared.shift = 0;
+    shared.digits = (shared.shift + CDSA_RADIX_SORT_DIGIT_BITS - 1)
+        / CDSA_RADIX_SORT_DIGIT_BITS;
+    radix_sort_run_workers(workers, num_threads, radix_sort_parallel_count);
+    /* Each worker scatters right after the previous workers' keys */
+    sum = 0;
+    for (b = 0; b < CDSA_RADIX_SORT_BUCKETS; b++)
+    {
+        shared.bucket_start[b] = sum;
+        for (i = 0; i < num_threads; i++)
+        {
+            count = workers[i].offsets[b];
+            workers[i].offsets[b] = sum;
+            sum += count;
+        }
+    }
+    shared.bucket_start[CDSA_RADIX_SORT_BUCKETS] = sum;
+    radix_sort_run_workers(workers, num_threads, radix_sort_parallel_scatter);
+    shared.next_bucket = 0;
+    pthread_mutex_init(&shared.lock, NULL);
+    radix_sort_run_workers(workers, num_threads, radix_sort_parallel_buckets);
+    pthread_mutex_destroy(&shared.lock);
+cleanup_radix_sort_parallel:
+    free(workers);
+    free(shared.buffer);
+}
@@ -0,0 +1,907 @@
+/**
+ * @file simple_bst.c
+ * @author HN Thap
+ * @brief Simple implementation of simple, unbalanced binary search tree.
+ * 
+ * @version 0.1
+ * @date 2025-08-11
+ * @copyright See LICENSE
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simple_bst.h"
+
+/**
+ * @brief Number of keys interleaved by the batch operations. Each round moves
+ * every key in the group one level down and prefetches the next node, so the
+ * memory loads of different keys overlap instead of waiting on each other.
+ */
+#define CDSA_SIMPLE_BST_BATCH_GROUP (16)
+
+/**
+ * @brief Hint the processor to start loading a node into cache.
+ */
+#if defined(__GNUC__)
+#define CDSA_SIMPLE_BST_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define CDSA_SIMPLE_BST_PREFETCH(p) ((void)(p))
+#endif
+
+/*
+ * Instrumentation. Define CDSA_SIMPLE_BST_STATS to count node allocations
+ * and frees, and the deepest level reached by push_bst(), in the global
+ * simple_bst_stats. Otherwise, the counting macros expand to nothing.
+ */
+#if defined(CDSA_SIMPLE_BST_STATS)
+SimpleBSTStats simple_bst_stats;
+
+#define CDSA_SIMPLE_BST_COUNT(field) ((void)(simple_bst_stats.field += 1))
+#define CDSA_SIMPLE_BST_DEPTH(depth) \
+    ((void)(simple_bst_stats.max_depth < (depth) \
+        && (simple_bst_stats.max_depth = (depth))))
+#else
+#define CDSA_SIMPLE_BST_COUNT(field) ((void)0)
+#define CDSA_SIMPLE_BST_DEPTH(depth) ((void)0)
+#endif
+
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+static int bst_size(const BSTNode *node)
+{
+    return node ? node->size : 0;
+}
+#endif
+
+static void bst_replace_node(
+    BST *tree,
+    BSTNode *parent,
+    unsigned char is_right_child,
+    BSTNode *new_node
+)
+{
+    if (parent == NULL) tree->root = new_node;
+    else if (is_right_child) parent->right = new_node;
+    else parent->left = new_node;
+}
+
+static int bst_collect_sorted(
+    const BST *tree,
+    int **values_ref,
+    int *count_ref
+)
+{
+    const BSTNode **stack = NULL;
+    const BSTNode **new_stack;
+    const BSTNode *node = tree->root;
+    int *values = NULL;
+    int *new_values;
+    int stack_count = 0, stack_capacity = 0, count = 0, capacity = 0;
+    while (node != NULL || stack_count > 0)
+    {
+        while (node != NULL)
+        {
+            if (stack_count == stack_capacity)
+            {
+                if (stack_capacity > INT_MAX / 2) goto cleanup_failed;
+                stack_capacity = stack_capacity ? 2 * stack_capacity : 64;
+                new_stack = realloc(
+                    (void *)stack,
+                    (size_t)stack_capacity * sizeof(*stack)
+                );
+                if (new_stack == NULL) goto cleanup_failed;
+                stack = new_stack;
+            }
+            stack[stack_count++] = node;
+            node = node->left;
+        }
+        node = stack[--stack_count];
+        if (count == capacity)
+        {
+            if (capacity > INT_MAX / 2) goto cleanup_failed;
+            capacity = capacity ? 2 * capacity : 64;
+            new_values = realloc(values, (size_t)capacity * sizeof(int));
+            if (new_values == NULL) goto cleanup_failed;
+            values = new_values;
+        }
+        values[count++] = node->data;
+        node = node->right;
+    }
+    free((void *)stack);
+    *values_ref = values;
+    *count_ref = count;
+    return CDSA_SIMPLE_BST_OK;
+cleanup_failed:
+    free((void *)stack);
+    free(values);
+    return CDSA_SIMPLE_BST_ALLOC_FAILED;
+}
+
+static void bst_fill_eytzinger(const int *sorted, int count, int *keys)
+{
+    int i, k = 1;
+    /* Start at the leftmost slot, then follow in-order successors */
+    while (k <= count / 2) k *= 2;
+    for (i = 0; i < count; i += 1)
+    {
+        keys[k] = sorted[i];
+        if (k <= (count - 1) / 2)
+        {
+            k = 2 * k + 1;
+            while (k <= count / 2) k *= 2;
+        }
+        else
+        {
+            while (k & 1) k >>= 1;
+            k >>= 1;
+        }
+    }
+}
+
+BSTNode *new_bst_node(int data, BSTNode *left, BSTNode *right)
+{
+    BSTNode *node = malloc(sizeof(BSTNode));
+    if (node == NULL)
+    {
+        fprintf(stderr, "Failed to create new BST node: failed to allocate.\n");
+        return NULL;
+    }
+    CDSA_SIMPLE_BST_COUNT(allocations);
+    node->data = data;
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+    node->size = 1 + bst_size(left) + bst_size(right);
+#endif
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+BST *new_bst()
+{
+    BST *tree = malloc(sizeof(BST));
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to create new BST: failed to allocate.\n");
+        return NULL;
+    }
+    tree->root = NULL;
+    return tree;
+}
+
+BST *build_bst_from_sorted(const int *arr, int n)
+{
+    BST *tree;
+    int i;
+    if (n < 0 || (arr == NULL && n > 0))
+    {
+        fprintf(stderr, "Failed to build BST: invalid array.\n");
+        return NULL;
+    }
+    for (i = 1; i < n; i += 1)
+    {
+        if (arr[i - 1] > arr[i])
+        {
+            fprintf(stderr, "Failed to build BST: array is not sorted.\n");
+            return NULL;
+        }
+    }
+    tree = new_bst();
+    if (tree == NULL) return NULL;
+    if (build_bst_from_sorted_recursive(arr, n, &tree->root)
+        != CDSA_SIMPLE_BST_OK)
+    {
+        fprintf(stderr, "Failed to build BST: failed to allocate memory.\n");
+        free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+int build_bst_from_sorted_recursive(
+    const int *arr,
+    int n,
+    BSTNode **node_ref
+)
+{
+    int middle = n / 2;
+    BSTNode *node;
+    *node_ref = NULL;
+    if (n == 0) return CDSA_SIMPLE_BST_OK;
+    node = new_bst_node(arr[middle], NULL, NULL);
+    if (node == NULL) return CDSA_SIMPLE_BST_ALLOC_FAILED;
+    if (build_bst_from_sorted_recursive(arr, middle, &node->left)
+        != CDSA_SIMPLE_BST_OK
+        || build_bst_from_sorted_recursive(
+            arr + middle + 1,
+            n - middle - 1,
+            &node->right
+        ) != CDSA_SIMPLE_BST_OK)
+    {
+        clear_bst_recursive(node);
+        return CDSA_SIMPLE_BST_ALLOC_FAILED;
+    }
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+    node->size = n;
+#endif
+    *node_ref = node;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int push_bst(BST *tree, int data)
+{
+    BSTNode **current;
+    BSTNode *node;
+#if defined(CDSA_SIMPLE_BST_STATS)
+    unsigned long depth = 1;
+#endif
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to push to BST: tree pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    /* Allocate first, so a failure leaves the tree untouched */
+    node = new_bst_node(data, NULL, NULL);
+    if (node == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to push to BST: failed to allocate memory.\n"
+        );
+        return CDSA_SIMPLE_BST_ALLOC_FAILED;
+    }
+    current = &(tree->root);
+    while (*current)
+    {
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+        (*current)->size += 1;
+#endif
+#if defined(CDSA_SIMPLE_BST_STATS)
+        depth += 1;
+#endif
+        if (data <= (*current)->data)
+        {
+            current = &((*current)->left);
+        }
+        else
+        {
+            current = &((*current)->right);
+        }
+    }
+    *current = node;
+    CDSA_SIMPLE_BST_DEPTH(depth);
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int push_bst_batch(BST *tree, const int *keys, int n)
+{
+    BSTNode **links[CDSA_SIMPLE_BST_BATCH_GROUP];
+    BSTNode *nodes[CDSA_SIMPLE_BST_BATCH_GROUP];
+    BSTNode **link;
+    BSTNode *node;
+    int active = 0, next = 0, j;
+    int rc = CDSA_SIMPLE_BST_OK;
+    if (tree == NULL || (keys == NULL && n > 0))
+    {
+        fprintf(stderr, "Failed to push batch to BST: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    while (1)
+    {
+        /* Each slot allocates its node up front; after a failure, the keys
+         * already in flight are still linked, but no new ones start */
+        while (active < CDSA_SIMPLE_BST_BATCH_GROUP && next < n)
+        {
+            nodes[active] = new_bst_node(keys[next++], NULL, NULL);
+            if (nodes[active] == NULL)
+            {
+                fprintf(
+                    stderr,
+                    "Failed to push batch to BST: failed to allocate memory.\n"
+                );
+                rc = CDSA_SIMPLE_BST_ALLOC_FAILED;
+                next = n;
+                break;
+            }
+            links[active++] = &(tree->root);
+        }
+        if (active == 0) break;
+        j = 0;
+        while (j < active)
+        {
+            link = links[j];
+            node = *link;
+            /* Links are re-read every round, so a node pushed by another
+             * slot in the group is simply descended through. */
+            if (node != NULL)
+            {
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+                node->size += 1;
+#endif
+                link = (nodes[j]->data <= node->data)
+                    ? &(node->left) : &(node->right);
+                CDSA_SIMPLE_BST_PREFETCH(*link);
+                links[j] = link;
+                j += 1;
+                continue;
+            }
+            *link = nodes[j];
+            /* Move the last slot here; it has not stepped this round */
+            active -= 1;
+            links[j] = links[active];
+            nodes[j] = nodes[active];
+        }
+    }
+    return rc;
+}
+
+int pop_bst_search(
+    BST *tree,
+    int data,
+    BSTNode **parent_ref,
+    BSTNode **node_ref,
+    unsigned char *is_right_child_ref
+)
+{
+    BSTNode *node, *parent;
+    unsigned char is_right_child = 0; /* Defensive initialization */
+    node = tree->root;
+    parent = NULL;
+    while (node != NULL && node->data != data)
+    {
+        parent = node;
+        if (data < node->data)
+        {
+            node = node->left;
+            is_right_child = 0;
+        }
+        else
+        {
+            node = node->right;
+            is_right_child = 1;
+        }
+    }
+    if (node == NULL) return CDSA_SIMPLE_BST_NOT_FOUND;
+    *node_ref = node;
+    *parent_ref = parent;
+    *is_right_child_ref = is_right_child;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int pop_bst(BST *tree, int data)
+{
+    BSTNode *node = NULL;
+    BSTNode *parent = NULL;
+    unsigned char is_right_child = 0;
+    BSTNode *pred_parent = NULL;
+    BSTNode *pred = NULL;
+    int rc;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to pop from BST: tree pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    rc = pop_bst_search(tree, data, &parent, &node, &is_right_child);
+    if (rc == CDSA_SIMPLE_BST_NOT_FOUND) return CDSA_SIMPLE_BST_NOT_FOUND;
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+    /* The same descent as pop_bst_search() reaches the same node */
+    for (pred = tree->root; pred != node; )
+    {
+        pred->size -= 1;
+        pred = (data < pred->data) ? pred->left : pred->right;
+    }
+    pred = NULL;
+#endif
+    /* Case 1: No children */
+    if (node->left == NULL && node->right == NULL)
+    {
+        bst_replace_node(tree, parent, is_right_child, NULL);
+        free(node);
+        CDSA_SIMPLE_BST_COUNT(frees);
+        return CDSA_SIMPLE_BST_OK;
+    }
+    /* Case 2: One child */
+    if (node->left == NULL || node->right == NULL)
+    {
+        bst_replace_node(
+            tree,
+            parent,
+            is_right_child,
+            (node->left ? node->left : node->right)
+        );
+        free(node);
+        CDSA_SIMPLE_BST_COUNT(frees);
+        return CDSA_SIMPLE_BST_OK;
+    }
+    /* Case 3: Two children - use inorder predecessor (max in left subtree) */
+    pred_parent = node;
+    pred = node->left;
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+    node->size -= 1;
+#endif
+    while (pred->right != NULL)
+    {
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+        pred->size -= 1;
+#endif
+        pred_parent = pred;
+        pred = pred->right;
+    }
+    node->data = pred->data;
+    if (pred_parent->right == pred)
+    {
+        pred_parent->right = pred->left;
+    }
+    else
+    {
+        pred_parent->left = pred->left;
+    }
+    free(pred);
+    CDSA_SIMPLE_BST_COUNT(frees);
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int search_bst(const BST *tree, int data)
+{
+    BSTNode *node;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to search BST: tree pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    node = tree->root;
+    while (node != NULL)
+    {
+        if (node->data == data) return CDSA_SIMPLE_BST_OK;
+        node = (node->data > data) ? node->left : node->right;
+    }
+    return CDSA_SIMPLE_BST_NOT_FOUND;
+}
+
+int search_bst_batch(const BST *tree, const int *keys, int n, int *results)
+{
+    const BSTNode *nodes[CDSA_SIMPLE_BST_BATCH_GROUP];
+    int slots[CDSA_SIMPLE_BST_BATCH_GROUP];
+    const BSTNode *node;
+    int active = 0, next = 0, j, key;
+    if (tree == NULL || ((keys == NULL || results == NULL) && n > 0))
+    {
+        fprintf(stderr, "Failed to search batch in BST: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    while (active < CDSA_SIMPLE_BST_BATCH_GROUP && next < n)
+    {
+        slots[active] = next++;
+        nodes[active++] = tree->root;
+    }
+    while (active > 0)
+    {
+        j = 0;
+        while (j < active)
+        {
+            node = nodes[j];
+            key = keys[slots[j]];
+            if (node != NULL && node->data != key)
+            {
+                node = (node->data > key) ? node->left : node->right;
+                CDSA_SIMPLE_BST_PREFETCH(node);
+                nodes[j] = node;
+                j += 1;
+                continue;
+            }
+            results[slots[j]] = node
+                ? CDSA_SIMPLE_BST_OK : CDSA_SIMPLE_BST_NOT_FOUND;
+            if (next < n)
+            {
+                slots[j] = next++;
+                nodes[j] = tree->root;
+                j += 1;
+            }
+            else
+            {
+                /* Move the last slot here; it has not stepped this round */
+                active -= 1;
+                slots[j] = slots[active];
+                nodes[j] = nodes[active];
+            }
+        }
+    }
+    return CDSA_SIMPLE_BST_OK;
+}
+
+FrozenBST *freeze_bst(const BST *tree)
+{
+    FrozenBST *frozen;
+    int *sorted = NULL;
+    int count = 0;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to freeze BST: tree pointer is NULL.\n");
+        return NULL;
+    }
+    if (bst_collect_sorted(tree, &sorted, &count) != CDSA_SIMPLE_BST_OK)
+    {
+        fprintf(stderr, "Failed to freeze BST: failed to allocate memory.\n");
+        return NULL;
+    }
+    frozen = malloc(sizeof(FrozenBST));
+    if (frozen == NULL)
+    {
+        fprintf(stderr, "Failed to freeze BST: failed to allocate memory.\n");
+        free(sorted);
+        return NULL;
+    }
+    frozen->keys = malloc(((size_t)count + 1) * sizeof(int));
+    if (frozen->keys == NULL)
+    {
+        fprintf(stderr, "Failed to freeze BST: failed to allocate memory.\n");
+        free(frozen);
+        free(sorted);
+        return NULL;
+    }
+    frozen->count = count;
+    bst_fill_eytzinger(sorted, count, frozen->keys);
+    free(sorted);
+    return frozen;
+}
+
+int search_frozen_bst(const FrozenBST *frozen, int data)
+{
+    const int *keys;
+    size_t k = 1, count;
+    if (frozen == NULL)
+    {
+        fprintf(stderr, "Failed to search frozen BST: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    keys = frozen->keys;
+    count = (size_t)frozen->count;
+    while (k <= count)
+    {
+        /* keys[16k..16k + 15] are the descendants four levels down */
+        CDSA_SIMPLE_BST_PREFETCH(keys + (16 * k <= count ? 16 * k : 0));
+        k = 2 * k + (size_t)(keys[k] < data);
+    }
+    /* Undo the right turns after the last left turn (the lower bound) */
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    return (k != 0 && keys[k] == data)
+        ? CDSA_SIMPLE_BST_OK : CDSA_SIMPLE_BST_NOT_FOUND;
+}
+
+int destroy_frozen_bst(FrozenBST **frozen_ref)
+{
+    if (frozen_ref == NULL)
+    {
+        fprintf(stderr, "Failed to destroy frozen BST: reference is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    if (*frozen_ref == NULL)
+    {
+        return CDSA_SIMPLE_BST_OK;
+    }
+    free((*frozen_ref)->keys);
+    free(*frozen_ref);
+    *frozen_ref = NULL;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+/* Push a pending node. When the stack is full, the bottom entry is dropped:
+ * it holds the largest pending key, so everything above it is still yielded
+ * in order, and bst_iterator_descend() finds the dropped keys again. */
+static void bst_iterator_push(BSTIterator *iterator, const BSTNode *node)
+{
+    if (iterator->top == CDSA_SIMPLE_BST_ITERATOR_DEPTH)
+    {
+        iterator->stack[iterator->bottom] = node;
+        iterator->bottom =
+            (iterator->bottom + 1) % CDSA_SIMPLE_BST_ITERATOR_DEPTH;
+        iterator->truncated = 1;
+        return;
+    }
+    iterator->stack[
+        (iterator->bottom + iterator->top) % CDSA_SIMPLE_BST_ITERATOR_DEPTH
+    ] = node;
+    iterator->top += 1;
+}
+
+/* Number of keys equal to data in a subtree. Pushes chain equal keys to the
+ * left, so this only recurses into the right subtrees of copies, which hold
+ * copies only when build_bst_from_sorted() spread them. */
+static int bst_iterator_copies(const BSTNode *node, int data)
+{
+    int copies = 0;
+    while (node != NULL)
+    {
+        if (node->data < data)
+        {
+            node = node->right;
+        }
+        else if (node->data > data)
+        {
+            node = node->left;
+        }
+        else
+        {
+            copies += 1 + bst_iterator_copies(node->right, data);
+            node = node->left;
+        }
+    }
+    return copies;
+}
+
+/* Descend from the root to the first key in [lo, hi], pushing the pending
+ * nodes, but skip the first skip copies of lo in order. Copies may lie on
+ * both sides of each other, so each one met is placed in order among the
+ * copies left in its subtree: those of its left subtree come first. */
+static void bst_iterator_descend(BSTIterator *iterator, int lo, int skip)
+{
+    const BSTNode *node;
+    int copies = -1; /* Copies of lo in the subtree of node, once counted */
+    int right_copies, left_copies;
+    iterator->top = 0;
+    iterator->bottom = 0;
+    iterator->truncated = 0;
+    node = iterator->root;
+    while (node != NULL)
+    {
+        if (node->data < lo)
+        {
+            node = node->right;
+            continue;
+        }
+        if (node->data > lo || skip == 0)
+        {
+            if (node->data <= iterator->hi) bst_iterator_push(iterator, node);
+            node = node->left;
+            continue;
+        }
+        if (copies < 0) copies = bst_iterator_copies(node, lo);
+        right_copies = bst_iterator_copies(node->right, lo);
+        left_copies = copies - 1 - right_copies;
+        if (skip <= left_copies)
+        {
+            /* node is still to be yielded, after the left_copies - skip
+             * copies of its left subtree that were not */
+            if (node->data <= iterator->hi) bst_iterator_push(iterator, node);
+            if (skip == left_copies) break;
+            copies = left_copies;
+            node = node->left;
+        }
+        else
+        {
+            /* node and its left subtree were yielded */
+            skip -= left_copies + 1;
+            copies = right_copies;
+            node = node->right;
+        }
+    }
+}
+
+int seek_bst_iterator(
+    const BST *tree,
+    int lo,
+    int hi,
+    BSTIterator *iterator
+)
+{
+    if (tree == NULL || iterator == NULL)
+    {
+        fprintf(stderr, "Failed to seek BST iterator: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    iterator->root = tree->root;
+    iterator->hi = hi;
+    iterator->last_copies = 0;
+    bst_iterator_descend(iterator, lo, 0);
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int next_bst_iterator(
+    BSTIterator *iterator,
+    int *out,
+    int capacity,
+    int *count_ref
+)
+{
+    const BSTNode *node;
+    int count = 0;
+    if (iterator == NULL || count_ref == NULL || (out == NULL && capacity > 0))
+    {
+        fprintf(stderr, "Failed to advance BST iterator: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    while (count < capacity)
+    {
+        if (iterator->top == 0)
+        {
+            if (!iterator->truncated) break;
+            /* Nodes were dropped: find the keys after the last one again. */
+            bst_iterator_descend(
+                iterator,
+                iterator->last,
+                iterator->last_copies
+            );
+            if (iterator->top == 0) break;
+        }
+        iterator->top -= 1;
+        node = iterator->stack[
+            (iterator->bottom + iterator->top)
+                % CDSA_SIMPLE_BST_ITERATOR_DEPTH
+        ];
+        out[count++] = node->data;
+        if (iterator->last_copies > 0 && node->data == iterator->last)
+        {
+            iterator->last_copies += 1;
+        }
+        else
+        {
+            iterator->last = node->data;
+            iterator->last_copies = 1;
+        }
+        /* The right subtree is not below node->data, so only keys above hi
+         * are skipped there */
+        for (node = node->right; node != NULL; node = node->left)
+        {
+            if (node->data <= iterator->hi) bst_iterator_push(iterator, node);
+        }
+    }
+    *count_ref = count;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int range_bst(
+    const BST *tree,
+    int lo,
+    int hi,
+    int *out,
+    int capacity,
+    int *count_ref
+)
+{
+    BSTIterator iterator;
+    int rc;
+    if (count_ref == NULL)
+    {
+        fprintf(stderr, "Failed to query BST range: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    *count_ref = 0;
+    rc = seek_bst_iterator(tree, lo, hi, &iterator);
+    if (rc != CDSA_SIMPLE_BST_OK) return rc;
+    return next_bst_iterator(&iterator, out, capacity, count_ref);
+}
+
+#if defined(CDSA_SIMPLE_BST_ORDER_STATISTICS)
+int select_kth_bst(const BST *tree, int k, int *data_ref)
+{
+    const BSTNode *node;
+    int left_size;
+    if (tree == NULL || data_ref == NULL)
+    {
+        fprintf(stderr, "Failed to select from BST: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    node = tree->root;
+    if (k < 0 || k >= bst_size(node)) return CDSA_SIMPLE_BST_NOT_FOUND;
+    while (1)
+    {
+        left_size = bst_size(node->left);
+        if (k == left_size) break;
+        if (k < left_size)
+        {
+            node = node->left;
+        }
+        else
+        {
+            k -= left_size + 1;
+            node = node->right;
+        }
+    }
+    *data_ref = node->data;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int rank_of_bst(const BST *tree, int data, int *rank_ref)
+{
+    const BSTNode *node;
+    int rank = 0;
+    if (tree == NULL || rank_ref == NULL)
+    {
+        fprintf(stderr, "Failed to rank in BST: pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    node = tree->root;
+    while (node != NULL)
+    {
+        if (node->data < data)
+        {
+            rank += bst_size(node->left) + 1;
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
+    }
+    *rank_ref = rank;
+    return CDSA_SIMPLE_BST_OK;
+}
+#endif
+
+void clear_bst_recursive(BSTNode *node)
+{
+    BSTNode *next;
+    /* Rotate right until the node has no left child, then free it and go
+     * on with its right child: no call stack, even on a degenerate tree. */
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            next = node->left;
+            node->left = next->right;
+            next->right = node;
+        }
+        else
+        {
+            next = node->right;
+            free(node);
+            CDSA_SIMPLE_BST_COUNT(frees);
+        }
+        node = next;
+    }
+}
+
+int clear_bst(BST *tree)
+{
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to clear BST: tree pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    clear_bst_recursive(tree->root);
+    tree->root = NULL;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+int destroy_bst(BST **tree_ref)
+{
+    if (tree_ref == NULL)
+    {
+        fprintf(stderr, "Failed to destroy BST: tree reference is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    if (*tree_ref == NULL)
+    {
+        return CDSA_SIMPLE_BST_OK;
+    }
+    /*
+     * As per current implementation of clear_bst(),
+     * since *tree_ref could not be NULL, clear_bst() would not fail.
+     */
+    (void)clear_bst(*tree_ref);
+    free(*tree_ref);
+    *tree_ref = NULL;
+    return CDSA_SIMPLE_BST_OK;
+}
+
+void print_bst_sideways_recursive(const BSTNode *node, int level)
+{
+    int i;
+    if (node == NULL) return;
+    print_bst_sideways_recursive(node->right, level + 1);
+    for (i = 0; i < level; i++) printf("    ");
+    printf("%d\n", node->data);
+    print_bst_sideways_recursive(node->left, level + 1);
+}
+
+int print_bst_sideways(const BST *tree)
+{
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to print BST sideways: tree pointer is NULL.\n");
+        return CDSA_SIMPLE_BST_NULL;
+    }
+    print_bst_sideways_recursive(tree->root, 0);
+    return CDSA_SIMPLE_BST_OK;
+}
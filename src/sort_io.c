@@ -0,0 +1,508 @@
+/**
+ * @file sort_io.c
+ * @author HN Thap
+ * @brief File input and output of int arrays, fast enough for the command
+ * line sorters to serve as pipeline stages over files of hundreds of
+ * millions of elements.
+ * 
+ * Binary files hold raw native-endian ints. On POSIX systems, sort_io_read()
+ * maps them privately (copy-on-write) instead of reading them, so the array
+ * is sorted right in the page cache and no copy is made up front. The
+ * standard input, and files that cannot be mapped, are read in large blocks
+ * instead. Binary output is written with a single fwrite().
+ * 
+ * Text files hold decimal ints separated by whitespace. They are parsed by
+ * hand out of CDSA_SORT_IO_BUFFER_SIZE byte blocks, and written one per line
+ * through a buffer of the same size, which costs far less than one scanf()
+ * or printf() per element.
+ * 
+ * On Windows, the standard streams are in text mode, so prefer file paths
+ * to "-" for binary data there.
+ * 
+ * @version 0.1
+ * @date 2026-10-14
+ * @copyright See LICENSE
+ */
+
+/* Needed for fstat() and mmap() under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#define CDSA_SORT_IO_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "sort_io.h"
+
+/**
+ * @brief Internal return code of sort_io_map_binary() when the file has to
+ * be read instead (not a regular file, or the mapping failed).
+ */
+#define CDSA_SORT_IO_NOT_MAPPED (-1)
+
+/**
+ * @brief Number of ints an allocated array starts with.
+ */
+#define CDSA_SORT_IO_INITIAL_CAPACITY (4096)
+
+/**
+ * @brief Longest formatted int, sign and newline included.
+ */
+#define CDSA_SORT_IO_MAX_FORMATTED (12)
+
+/**
+ * @brief Grow an allocated array to hold at least one more int.
+ * 
+ * @param array The array
+ * @return int CDSA_SORT_IO_OK if success,
+ * or CDSA_SORT_IO_FAILED if the array already holds INT_MAX ints,
+ * otherwise, CDSA_SORT_IO_ALLOC_FAILED.
+ */
+static int sort_io_grow(SortIOArray *array);
+
+/**
+ * @brief Map a binary file privately into memory.
+ * 
+ * @param path Path of the file
+ * @param array Where to store the array
+ * @return int CDSA_SORT_IO_OK if success, CDSA_SORT_IO_NOT_MAPPED if the file
+ * has to be read instead, otherwise, an error code of sort_io_read().
+ */
+static int sort_io_map_binary(const char *path, SortIOArray *array);
+
+/**
+ * @brief Read a binary stream into an allocated array.
+ * 
+ * @param file The stream
+ * @param path Path of the stream, for error messages
+ * @param array Where to store the array
+ * @return int Same as sort_io_read()
+ */
+static int sort_io_read_binary(
+    FILE *file,
+    const char *path,
+    SortIOArray *array
+);
+
+/**
+ * @brief Parse a text stream into an allocated array.
+ * 
+ * @param file The stream
+ * @param path Path of the stream, for error messages
+ * @param array Where to store the array
+ * @return int Same as sort_io_read()
+ */
+static int sort_io_read_text(
+    FILE *file,
+    const char *path,
+    SortIOArray *array
+);
+
+/**
+ * @brief Write an int array to a stream, one decimal int per line.
+ * 
+ * @param file The stream
+ * @param count Size of the array
+ * @param data The array
+ * @return int CDSA_SORT_IO_OK if success, otherwise, CDSA_SORT_IO_FAILED.
+ */
+static int sort_io_write_text(FILE *file, int count, const int *data);
+
+int sort_io_read(const char *path, int format, SortIOArray *array)
+{
+    FILE *file;
+    int rc, is_stdin;
+    if (path == NULL || array == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to read: invalid parameter: "
+            "path and array cannot be NULL.\n"
+        );
+        return CDSA_SORT_IO_NULL;
+    }
+    if (format != CDSA_SORT_IO_FORMAT_BINARY
+        && format != CDSA_SORT_IO_FORMAT_TEXT)
+    {
+        fprintf(stderr, "Failed to read %s: unknown format.\n", path);
+        return CDSA_SORT_IO_INVALID;
+    }
+    memset(array, 0, sizeof(SortIOArray));
+    is_stdin = strcmp(path, "-") == 0;
+    if (format == CDSA_SORT_IO_FORMAT_BINARY && !is_stdin)
+    {
+        rc = sort_io_map_binary(path, array);
+        if (rc != CDSA_SORT_IO_NOT_MAPPED) return rc;
+    }
+    file = is_stdin ? stdin : fopen(path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to read %s: failed to open.\n", path);
+        return CDSA_SORT_IO_FAILED;
+    }
+    rc = (format == CDSA_SORT_IO_FORMAT_BINARY)
+        ? sort_io_read_binary(file, path, array)
+        : sort_io_read_text(file, path, array);
+    if (!is_stdin) fclose(file);
+    if (rc != CDSA_SORT_IO_OK) sort_io_release(array);
+    return rc;
+}
+
+int sort_io_write(const char *path, int format, int count, const int *data)
+{
+    FILE *file;
+    int rc = CDSA_SORT_IO_OK;
+    int is_stdout;
+    if (path == NULL || (data == NULL && count > 0))
+    {
+        fprintf(
+            stderr,
+            "Failed to write: invalid parameter: "
+            "path and data cannot be NULL.\n"
+        );
+        return CDSA_SORT_IO_NULL;
+    }
+    if (format != CDSA_SORT_IO_FORMAT_BINARY
+        && format != CDSA_SORT_IO_FORMAT_TEXT)
+    {
+        fprintf(stderr, "Failed to write %s: unknown format.\n", path);
+        return CDSA_SORT_IO_INVALID;
+    }
+    is_stdout = strcmp(path, "-") == 0;
+    file = is_stdout ? stdout : fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to write %s: failed to open.\n", path);
+        return CDSA_SORT_IO_FAILED;
+    }
+    if (count > 0 && format == CDSA_SORT_IO_FORMAT_BINARY)
+    {
+        if (fwrite(data, sizeof(int), (size_t)count, file) != (size_t)count)
+        {
+            rc = CDSA_SORT_IO_FAILED;
+        }
+    }
+    else if (count > 0)
+    {
+        rc = sort_io_write_text(file, count, data);
+    }
+    if (is_stdout)
+    {
+        if (fflush(file) != 0) rc = CDSA_SORT_IO_FAILED;
+    }
+    else if (fclose(file) != 0)
+    {
+        rc = CDSA_SORT_IO_FAILED;
+    }
+    if (rc != CDSA_SORT_IO_OK)
+    {
+        fprintf(stderr, "Failed to write %s.\n", path);
+    }
+    return rc;
+}
+
+void sort_io_release(SortIOArray *array)
+{
+    if (array == NULL) return;
+#if defined(CDSA_SORT_IO_MMAP)
+    if (array->mapping != NULL)
+    {
+        munmap(array->mapping, array->mapping_size);
+    }
+    else
+    {
+        free(array->data);
+    }
+#else
+    free(array->data);
+#endif
+    memset(array, 0, sizeof(SortIOArray));
+}
+
+int sort_io_parse_format(const char *option, int *format_ref)
+{
+    if (option == NULL || format_ref == NULL) return CDSA_SORT_IO_INVALID;
+    if (strcmp(option, "--binary") == 0)
+    {
+        *format_ref = CDSA_SORT_IO_FORMAT_BINARY;
+        return CDSA_SORT_IO_OK;
+    }
+    if (strcmp(option, "--text") == 0)
+    {
+        *format_ref = CDSA_SORT_IO_FORMAT_TEXT;
+        return CDSA_SORT_IO_OK;
+    }
+    return CDSA_SORT_IO_INVALID;
+}
+
+static int sort_io_grow(SortIOArray *array)
+{
+    int *data;
+    int capacity;
+    if (array->capacity == INT_MAX) return CDSA_SORT_IO_FAILED;
+    if (array->capacity == 0) capacity = CDSA_SORT_IO_INITIAL_CAPACITY;
+    else if (array->capacity > INT_MAX / 2) capacity = INT_MAX;
+    else capacity = 2 * array->capacity;
+    if ((size_t)capacity > (size_t)-1 / sizeof(int))
+    {
+        return CDSA_SORT_IO_ALLOC_FAILED;
+    }
+    data = realloc(array->data, (size_t)capacity * sizeof(int));
+    if (data == NULL) return CDSA_SORT_IO_ALLOC_FAILED;
+    array->data = data;
+    array->capacity = capacity;
+    return CDSA_SORT_IO_OK;
+}
+
+static int sort_io_map_binary(const char *path, SortIOArray *array)
+{
+#if defined(CDSA_SORT_IO_MMAP)
+    struct stat info;
+    void *mapping;
+    size_t size;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Failed to read %s: failed to open.\n", path);
+        return CDSA_SORT_IO_FAILED;
+    }
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        close(fd);
+        return CDSA_SORT_IO_NOT_MAPPED;
+    }
+    if (info.st_size % (off_t)sizeof(int) != 0)
+    {
+        fprintf(
+            stderr,
+            "Failed to read %s: size is not a multiple of %d bytes.\n",
+            path,
+            (int)sizeof(int)
+        );
+        close(fd);
+        return CDSA_SORT_IO_INVALID;
+    }
+    if (info.st_size / (off_t)sizeof(int) > INT_MAX)
+    {
+        fprintf(stderr, "Failed to read %s: too many elements.\n", path);
+        close(fd);
+        return CDSA_SORT_IO_FAILED;
+    }
+    size = (size_t)info.st_size;
+    if (size == 0)
+    {
+        close(fd);
+        return CDSA_SORT_IO_OK;
+    }
+    /* Private and writable: sorting in-place never writes back to the file */
+    mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return CDSA_SORT_IO_NOT_MAPPED;
+    /* Fault the pages in ahead of the sort, which touches all of them */
+    (void)posix_madvise(mapping, size, POSIX_MADV_WILLNEED);
+    array->data = mapping;
+    array->count = (int)(size / sizeof(int));
+    array->mapping = mapping;
+    array->mapping_size = size;
+    return CDSA_SORT_IO_OK;
+#else
+    (void)path;
+    (void)array;
+    return CDSA_SORT_IO_NOT_MAPPED;
+#endif
+}
+
+static int sort_io_read_binary(
+    FILE *file,
+    const char *path,
+    SortIOArray *array
+)
+{
+    size_t bytes = 0; /* Bytes read into array->data */
+    size_t length;
+    int rc;
+    for (;;)
+    {
+        if (bytes == (size_t)array->capacity * sizeof(int))
+        {
+            rc = sort_io_grow(array);
+            if (rc != CDSA_SORT_IO_OK)
+            {
+                fprintf(
+                    stderr,
+                    "Failed to read %s: %s.\n",
+                    path,
+                    (rc == CDSA_SORT_IO_FAILED)
+                        ? "too many elements"
+                        : "failed to allocate"
+                );
+                return rc;
+            }
+        }
+        length = fread(
+            (unsigned char *)array->data + bytes,
+            1,
+            (size_t)array->capacity * sizeof(int) - bytes,
+            file
+        );
+        bytes += length;
+        if (length == 0) break;
+    }
+    if (ferror(file))
+    {
+        fprintf(stderr, "Failed to read %s.\n", path);
+        return CDSA_SORT_IO_FAILED;
+    }
+    if (bytes % sizeof(int) != 0)
+    {
+        fprintf(
+            stderr,
+            "Failed to read %s: size is not a multiple of %d bytes.\n",
+            path,
+            (int)sizeof(int)
+        );
+        return CDSA_SORT_IO_INVALID;
+    }
+    array->count = (int)(bytes / sizeof(int));
+    return CDSA_SORT_IO_OK;
+}
+
+static int sort_io_read_text(
+    FILE *file,
+    const char *path,
+    SortIOArray *array
+)
+{
+    char buffer[CDSA_SORT_IO_BUFFER_SIZE];
+    unsigned long value = 0, limit = INT_MAX;
+    unsigned long line = 1;
+    size_t length, i;
+    int in_token = 0, digits = 0, negative = 0;
+    int rc, c, end;
+    do
+    {
+        length = fread(buffer, 1, sizeof(buffer), file);
+        end = length < sizeof(buffer);
+        for (i = 0; i <= length; i++)
+        {
+            /* A block that ends the file ends its last token as well */
+            if (i == length && !end) break;
+            c = (i < length) ? (unsigned char)buffer[i] : '\n';
+            if (c >= '0' && c <= '9')
+            {
+                if (value > (limit - (unsigned long)(c - '0')) / 10) break;
+                value = 10 * value + (unsigned long)(c - '0');
+                in_token = 1;
+                digits += 1;
+            }
+            else if ((c == '-' || c == '+') && !in_token)
+            {
+                negative = c == '-';
+                limit = negative ? (unsigned long)INT_MAX + 1 : INT_MAX;
+                in_token = 1;
+            }
+            else if (c == ' ' || c == '\n' || c == '\t' || c == '\r'
+                || c == '\v' || c == '\f')
+            {
+                if (in_token)
+                {
+                    if (digits == 0) break;
+                    if (array->count == array->capacity)
+                    {
+                        rc = sort_io_grow(array);
+                        if (rc != CDSA_SORT_IO_OK)
+                        {
+                            fprintf(
+                                stderr,
+                                "Failed to read %s: %s.\n",
+                                path,
+                                (rc == CDSA_SORT_IO_FAILED)
+                                    ? "too many elements"
+                                    : "failed to allocate"
+                            );
+                            return rc;
+                        }
+                    }
+                    /* -(INT_MAX + 1) does not fit before the negation */
+                    array->data[array->count++] = negative
+                        ? -(int)(value - 1) - 1
+                        : (int)value;
+                    value = 0;
+                    limit = INT_MAX;
+                    in_token = 0;
+                    digits = 0;
+                    negative = 0;
+                }
+                line += c == '\n';
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (i < length || (i == length && end && in_token))
+        {
+            fprintf(
+                stderr,
+                "Failed to read %s: invalid int on line %lu.\n",
+                path,
+                line
+            );
+            return CDSA_SORT_IO_INVALID;
+        }
+    } while (!end);
+    if (ferror(file))
+    {
+        fprintf(stderr, "Failed to read %s.\n", path);
+        return CDSA_SORT_IO_FAILED;
+    }
+    return CDSA_SORT_IO_OK;
+}
+
+static int sort_io_write_text(FILE *file, int count, const int *data)
+{
+    char buffer[CDSA_SORT_IO_BUFFER_SIZE];
+    char digits[CDSA_SORT_IO_MAX_FORMATTED];
+    char *out = buffer;
+    char *last = buffer + sizeof(buffer) - CDSA_SORT_IO_MAX_FORMATTED;
+    unsigned int magnitude;
+    int i, length;
+    for (i = 0; i < count; i++)
+    {
+        if (out > last)
+        {
+            if (fwrite(buffer, 1, (size_t)(out - buffer), file)
+                != (size_t)(out - buffer))
+            {
+                return CDSA_SORT_IO_FAILED;
+            }
+            out = buffer;
+        }
+        magnitude = (data[i] < 0)
+            ? 0u - (unsigned int)data[i]
+            : (unsigned int)data[i];
+        length = 0;
+        do
+        {
+            digits[length++] = (char)('0' + magnitude % 10u);
+            magnitude /= 10u;
+        } while (magnitude != 0);
+        if (data[i] < 0) *out++ = '-';
+        while (length > 0) *out++ = digits[--length];
+        *out++ = '\n';
+    }
+    if (fwrite(buffer, 1, (size_t)(out - buffer), file)
+        != (size_t)(out - buffer))
+    {
+        return CDSA_SORT_IO_FAILED;
+    }
+    return CDSA_SORT_IO_OK;
+}
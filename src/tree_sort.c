@@ -0,0 +1,1118 @@
+/**
+ * @file tree_sort.c
+ * @author HN Thap
+ * @brief An implementation of a Tree sort algorithm.
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ * 
+ * tree_sort_with_backend() can insert into an AVL tree (avl_tree.c) instead
+ * of the simple BST (CDSA_TREE_SORT_BACKEND_AVL), which guarantees
+ * O(n log n) even on sorted or reverse-sorted input.
+ * 
+ * CDSA_TREE_SORT_BACKEND_BPLUS inserts into a B+ tree (b_plus_tree.c) with
+ * cache-line sized nodes instead, and reads the result back along its linked
+ * leaves.
+ * 
+ * tree_sort_parallel() spreads any backend over POSIX threads: the keys are
+ * partitioned into one bucket per thread around splitters taken from a
+ * sorted sample, then every thread builds the tree of its own bucket, from
+ * its own arena, and writes it out in order at the bucket's offset in arr.
+ * The buckets cover disjoint key ranges, so no merge is needed afterwards.
+ * 
+ * The trees are read back (Morris traversal) and freed (rotations) in O(1)
+ * extra memory, so even the degenerate BST built from sorted input cannot
+ * overflow the call stack.
+ */
+
+/* Needed for POSIX threads under -std=c90. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avl_tree.h"
+#include "b_plus_tree.h"
+#include "tree_sort.h"
+
+/**
+ * @brief Maximum number of threads of tree_sort_parallel().
+ */
+#define CDSA_TREE_SORT_PARALLEL_MAX_THREADS (256)
+
+/**
+ * @brief Minimum number of keys per bucket of tree_sort_parallel(). Smaller
+ * arrays use fewer threads, down to the sequential sort.
+ */
+#define CDSA_TREE_SORT_PARALLEL_MIN_BUCKET (16384)
+
+/**
+ * @brief Number of sampled keys per bucket, which the splitters between
+ * buckets are picked from.
+ */
+#define CDSA_TREE_SORT_PARALLEL_OVERSAMPLING (32)
+
+/**
+ * @brief Phases of tree_sort_parallel(): count the keys of each bucket,
+ * scatter them into their buckets, then sort each bucket.
+ */
+#define CDSA_TREE_SORT_PARALLEL_COUNT (0)
+#define CDSA_TREE_SORT_PARALLEL_SCATTER (1)
+#define CDSA_TREE_SORT_PARALLEL_BUILD (2)
+
+/*
+ * Instrumentation. Define CDSA_TREE_SORT_STATS to count, in the global
+ * tree_sort_stats, the heap allocations (nodes and arenas) and frees, and
+ * the deepest level reached by push_bst(). AVL rotations are counted by
+ * avl_tree.c (CDSA_AVL_TREE_STATS). Otherwise, the counting macros expand to
+ * nothing.
+ */
+#if defined(CDSA_TREE_SORT_STATS)
+TreeSortStats tree_sort_stats;
+
+#define CDSA_TREE_SORT_COUNT(field) ((void)(tree_sort_stats.field += 1))
+#define CDSA_TREE_SORT_DEPTH(depth) \
+    ((void)(tree_sort_stats.max_depth < (depth) \
+        && (tree_sort_stats.max_depth = (depth))))
+#else
+#define CDSA_TREE_SORT_COUNT(field) ((void)0)
+#define CDSA_TREE_SORT_DEPTH(depth) ((void)0)
+#endif
+
+/**
+ * @brief Basic structure for a BST node.
+ * 
+ * Equal keys share one node and only bump its count, so the tree's size and
+ * depth follow the number of distinct keys rather than the array size.
+ */
+typedef struct BSTNode
+{
+    int data;
+    int count; /* Number of pushed keys equal to data */
+    struct BSTNode *left;
+    struct BSTNode *right;
+} BSTNode;
+
+/**
+ * @brief Basic structure for a BST.
+ * 
+ * When arena is not NULL, nodes are taken from that single contiguous block
+ * of arena_capacity nodes instead of being allocated one by one, and
+ * clearing the tree releases all of them at once.
+ * 
+ * The last three fields are only maintained by push_bst_bounded().
+ */
+typedef struct BST
+{
+    BSTNode *root;
+    BSTNode *arena;
+    int arena_count;
+    int arena_capacity;
+    int size; /* Number of keys held, duplicates included */
+    int max_data; /* Largest key held, when size > 0 */
+    BSTNode *free_nodes; /* Dropped nodes, linked through left */
+} BST;
+
+/**
+ * @brief A Tree sort backend, which sorts arr_count (at least 2) keys of
+ * input into output (which may be input itself).
+ */
+typedef int (*TreeSortInto)(int arr_count, const int input[], int output[]);
+
+/**
+ * @brief Shared state of tree_sort_parallel(). Worker t scatters its next key
+ * of bucket b to buffer[offsets[t * bucket_count + b]], and bucket b ends up
+ * in arr[bucket_start[b], bucket_start[b + 1]).
+ */
+typedef struct TreeSortParallel
+{
+    int *arr;
+    int *buffer;
+    int arr_count;
+    TreeSortInto sort_into; /* Backend of every bucket */
+    int bucket_count; /* Also the number of workers */
+    int phase;
+    int splitters[CDSA_TREE_SORT_PARALLEL_MAX_THREADS - 1];
+    int bucket_start[CDSA_TREE_SORT_PARALLEL_MAX_THREADS + 1];
+    int *offsets;
+} TreeSortParallel;
+
+/**
+ * @brief A worker of tree_sort_parallel(), which counts and scatters
+ * arr[start, end), then sorts bucket id.
+ */
+typedef struct TreeSortWorker
+{
+    TreeSortParallel *sort;
+    int id;
+    int start;
+    int end;
+    int rc;
+} TreeSortWorker;
+
+/**
+ * @brief Allocate and initialize new BST node.
+ * 
+ * @param data Data
+ * @param left Pointer to left child (NULL if not presenting)
+ * @param right Pointer to right child (NULL if not presenting)
+ * @return BSTNode* Pointer to new allocated block
+ */
+static BSTNode *new_bst_node(int data, BSTNode *left, BSTNode *right);
+
+/**
+ * @brief Allocate and initialize an empty BST.
+ * 
+ * @return BST* Pointer to new allocated block
+ */
+static BST *new_bst();
+
+/**
+ * @brief Allocate and initialize an empty BST whose nodes come from an arena
+ * of a fixed number of nodes, allocated in one block.
+ * 
+ * @param capacity Maximum number of nodes
+ * @return BST* Pointer to new allocated block,
+ * otherwise, NULL when allocation fails
+ */
+static BST *new_bst_with_arena(int capacity);
+
+/**
+ * @brief Take a new node from the tree's arena, or allocate it when the
+ * tree has no arena.
+ * 
+ * @param tree Pointer to BST
+ * @param data Data
+ * @return BSTNode* Pointer to the new node,
+ * otherwise, NULL when allocation fails or the arena is full
+ */
+static BSTNode *new_bst_tree_node(BST *tree, int data);
+
+/**
+ * @brief Push new key to a BST. A key equal to a stored one increments that
+ * node's count instead of adding a node.
+ * 
+ * @param tree Pointer to BST
+ * @param data Data to be stored
+ * @return int CDSA_TREE_SORT_OK if success,
+ * otherwise, CDSA_TREE_SORT_ALLOC_FAILED when failed to allocate node.
+ */
+static int push_bst(BST *tree, int data);
+
+/**
+ * @brief Push new key to a BST that only keeps its limit smallest keys,
+ * duplicates included. When the tree is full, either the new key or one copy
+ * of the largest key leaves, whichever is larger. Dropped nodes are reused by
+ * later pushes, so the tree never holds more than limit + 1 nodes.
+ * 
+ * @param tree Pointer to BST
+ * @param data Data to be stored
+ * @param limit Maximum number of keys
+ * @param dropped_ref Reference to store the dropped key
+ * @return int CDSA_TREE_SORT_OK if the key was added with nothing dropped,
+ * or CDSA_TREE_SORT_DROPPED if *dropped_ref left the tree (or never entered),
+ * otherwise, CDSA_TREE_SORT_ALLOC_FAILED when failed to allocate node, in
+ * which case the tree is unchanged.
+ */
+static int push_bst_bounded(BST *tree, int data, int limit, int *dropped_ref);
+
+/**
+ * @brief Free a BST node and all of its children (particularly used inside
+ * clear_bst()), without recursion nor extra memory: while the node has a
+ * left child, it is rotated right, then it is freed and its right child
+ * takes its place.
+ * 
+ * @param node Pointer to BST node.
+ */
+static void clear_bst_nodes(BSTNode *node);
+
+/**
+ * @brief Clear a BST (without destroying it).
+ * 
+ * @param tree Pointer to BST
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the tree pointer is NULL.
+ */
+static int clear_bst(BST *tree);
+
+/**
+ * @brief Destroy a BST.
+ * 
+ * @param tree_ref Reference of the pointer to BST
+ * @return int CDSA_SIMPLE_BST_OK if success,
+ * otherwise, CDSA_SIMPLE_BST_NULL when the BST reference is NULL.
+ */
+static int destroy_bst(BST **tree_ref);
+
+/**
+ * @brief Traverse a BST in order to write it into an array (particularly
+ * used inside tree_sort()), without recursion nor extra memory (Morris
+ * traversal). Each node is written count times.
+ * 
+ * Before going down the left subtree of a node, the right link of its
+ * predecessor is pointed back at it, which leads back once the subtree is
+ * done. Every such thread is removed on the way back, so the tree is intact
+ * afterwards, and the walk takes at most three steps per node.
+ * 
+ * @param arr Array
+ * @param node Root node of the BST
+ */
+static void tree_sort_in_order(int arr[], BSTNode *node);
+
+/**
+ * @brief Traverse an AVL tree in order to write it into an array
+ * (particularly used inside tree_sort_avl()), like tree_sort_in_order().
+ * 
+ * @param arr Array
+ * @param node Root node of the AVL tree
+ */
+static void tree_sort_avl_in_order(int arr[], AVLNode *node);
+
+static BSTNode *new_bst_node(int data, BSTNode *left, BSTNode *right)
+{
+    BSTNode *node = malloc(sizeof(BSTNode));
+    if (node == NULL)
+    {
+        fprintf(stderr, "Failed to create new BST node: failed to allocate.\n");
+        return NULL;
+    }
+    CDSA_TREE_SORT_COUNT(allocations);
+    node->data = data;
+    node->count = 1;
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+static BST *new_bst()
+{
+    BST *tree = malloc(sizeof(BST));
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to create new BST: failed to allocate.\n");
+        return NULL;
+    }
+    tree->root = NULL;
+    tree->arena = NULL;
+    tree->arena_count = 0;
+    tree->arena_capacity = 0;
+    tree->size = 0;
+    tree->max_data = 0;
+    tree->free_nodes = NULL;
+    return tree;
+}
+
+static BST *new_bst_with_arena(int capacity)
+{
+    BST *tree = new_bst();
+    if (tree == NULL) return NULL;
+    if (capacity < 1) capacity = 1;
+    tree->arena = malloc(capacity * sizeof(BSTNode));
+    if (tree->arena == NULL)
+    {
+        fprintf(
+            stderr,
+            "Failed to create new BST: failed to allocate arena.\n"
+        );
+        free(tree);
+        return NULL;
+    }
+    CDSA_TREE_SORT_COUNT(allocations);
+    tree->arena_capacity = capacity;
+    return tree;
+}
+
+static BSTNode *new_bst_tree_node(BST *tree, int data)
+{
+    BSTNode *node;
+    if (tree->arena == NULL) return new_bst_node(data, NULL, NULL);
+    if (tree->arena_count == tree->arena_capacity)
+    {
+        fprintf(stderr, "Failed to create new BST node: arena is full.\n");
+        return NULL;
+    }
+    node = &tree->arena[tree->arena_count++];
+    node->data = data;
+    node->count = 1;
+    node->left = NULL;
+    node->right = NULL;
+    return node;
+}
+
+static int push_bst(BST *tree, int data)
+{
+    BSTNode *parent;
+#if defined(CDSA_TREE_SORT_STATS)
+    unsigned long depth = 1;
+#endif
+    if (tree->root == NULL)
+    {
+        tree->root = new_bst_tree_node(tree, data);
+        if (tree->root == NULL)
+        {
+            fprintf(
+                stderr,
+                "Failed to push to BST: failed to allocate memory.\n"
+            );
+            return CDSA_TREE_SORT_ALLOC_FAILED;
+        }
+        return CDSA_TREE_SORT_OK;
+    }
+    parent = tree->root;
+    while (1) /* Loop termination is warranteed. */
+    {
+        if (data == parent->data)
+        {
+            parent->count += 1;
+            CDSA_TREE_SORT_DEPTH(depth);
+            return CDSA_TREE_SORT_OK;
+        }
+        if (data < parent->data)
+        {
+            if (parent->left == NULL)
+            {
+                parent->left = new_bst_tree_node(tree, data);
+                if (parent->left == NULL)
+                {
+                    fprintf(
+                        stderr,
+                        "Failed to push to BST: failed to allocate memory.\n"
+                    );
+                    return CDSA_TREE_SORT_ALLOC_FAILED;
+                }
+                CDSA_TREE_SORT_DEPTH(depth + 1);
+                return CDSA_TREE_SORT_OK;
+            }
+            parent = parent->left;
+        }
+        else
+        {
+            if (parent->right == NULL)
+            {
+                parent->right = new_bst_tree_node(tree, data);
+                if (parent->right == NULL)
+                {
+                    fprintf(
+                        stderr,
+                        "Failed to push to BST: failed to allocate memory.\n"
+                    );
+                    return CDSA_TREE_SORT_ALLOC_FAILED;
+                }
+                CDSA_TREE_SORT_DEPTH(depth + 1);
+                return CDSA_TREE_SORT_OK;
+            }
+            parent = parent->right;
+        }
+#if defined(CDSA_TREE_SORT_STATS)
+        depth += 1;
+#endif
+    }
+}
+
+static int push_bst_bounded(BST *tree, int data, int limit, int *dropped_ref)
+{
+    BSTNode **link;
+    BSTNode *node;
+    int rc = CDSA_TREE_SORT_OK;
+    if (tree->size >= limit && (limit <= 0 || data >= tree->max_data))
+    {
+        *dropped_ref = data;
+        return CDSA_TREE_SORT_DROPPED;
+    }
+    if (tree->free_nodes == NULL)
+    {
+        /* Take a node up front, so that a failure leaves the tree as is. */
+        node = new_bst_tree_node(tree, data);
+        if (node == NULL)
+        {
+            fprintf(
+                stderr,
+                "Failed to push to BST: failed to allocate memory.\n"
+            );
+            return CDSA_TREE_SORT_ALLOC_FAILED;
+        }
+        node->left = NULL;
+        tree->free_nodes = node;
+    }
+    if (tree->size >= limit)
+    {
+        /* Make room by dropping one copy of the largest key. */
+        link = &tree->root;
+        while ((*link)->right != NULL) link = &(*link)->right;
+        node = *link;
+        *dropped_ref = node->data;
+        node->count -= 1;
+        tree->size -= 1;
+        if (node->count == 0)
+        {
+            *link = node->left;
+            node->left = tree->free_nodes;
+            tree->free_nodes = node;
+        }
+        rc = CDSA_TREE_SORT_DROPPED;
+    }
+    link = &tree->root;
+    while (*link != NULL && (*link)->data != data)
+    {
+        link = (data < (*link)->data) ? &(*link)->left : &(*link)->right;
+    }
+    if (*link != NULL)
+    {
+        (*link)->count += 1;
+    }
+    else
+    {
+        node = tree->free_nodes;
+        tree->free_nodes = node->left;
+        node->data = data;
+        node->count = 1;
+        node->left = NULL;
+        node->right = NULL;
+        *link = node;
+    }
+    tree->size += 1;
+    if (rc == CDSA_TREE_SORT_DROPPED)
+    {
+        /* The largest key may have left: find the new one. */
+        node = tree->root;
+        while (node->right != NULL) node = node->right;
+        tree->max_data = node->data;
+    }
+    else if (tree->size == 1 || data > tree->max_data)
+    {
+        tree->max_data = data;
+    }
+    return rc;
+}
+
+static void clear_bst_nodes(BSTNode *node)
+{
+    BSTNode *next;
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            next = node->left;
+            node->left = next->right;
+            next->right = node;
+        }
+        else
+        {
+            next = node->right;
+            free(node);
+            CDSA_TREE_SORT_COUNT(frees);
+        }
+        node = next;
+    }
+}
+
+static int clear_bst(BST *tree)
+{
+    BSTNode *node;
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Failed to clear BST: tree is NULL.\n");
+        return CDSA_TREE_SORT_NULL;
+    }
+    tree->size = 0;
+    while (tree->arena == NULL && tree->free_nodes != NULL)
+    {
+        node = tree->free_nodes;
+        tree->free_nodes = node->left;
+        free(node);
+        CDSA_TREE_SORT_COUNT(frees);
+    }
+    tree->free_nodes = NULL;
+    if (tree->arena != NULL)
+    {
+        /* Every node lives in the arena, so dropping them all is O(1). */
+        tree->root = NULL;
+        tree->arena_count = 0;
+        return CDSA_TREE_SORT_OK;
+    }
+    clear_bst_nodes(tree->root);
+    tree->root = NULL;
+    return CDSA_TREE_SORT_OK;
+}
+
+static int destroy_bst(BST **tree_ref)
+{
+    if (tree_ref == NULL)
+    {
+        fprintf(stderr, "Failed to destroy BST: tree reference is NULL.\n");
+        return CDSA_TREE_SORT_NULL;
+    }
+    if (*tree_ref == NULL)
+    {
+        return CDSA_TREE_SORT_OK;
+    }
+    /*
+     * As per current implementation of clear_bst(),
+     * since *tree_ref could not be NULL, clear_bst() would not fail.
+     */
+    (void)clear_bst(*tree_ref);
+    if ((*tree_ref)->arena != NULL) CDSA_TREE_SORT_COUNT(frees);
+    free((*tree_ref)->arena);
+    free(*tree_ref);
+    *tree_ref = NULL;
+    return CDSA_TREE_SORT_OK;
+}
+
+static void tree_sort_in_order(int arr[], BSTNode *node)
+{
+    BSTNode *predecessor;
+    int i, index = 0;
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            predecessor = node->left;
+            while (predecessor->right != NULL && predecessor->right != node)
+            {
+                predecessor = predecessor->right;
+            }
+            if (predecessor->right == NULL)
+            {
+                /* Thread the predecessor, then do the left subtree. */
+                predecessor->right = node;
+                node = node->left;
+                continue;
+            }
+            /* Back from the left subtree: remove the thread. */
+            predecessor->right = NULL;
+        }
+        for (i = 0; i < node->count; i += 1)
+        {
+            arr[index++] = node->data;
+        }
+        node = node->right;
+    }
+}
+
+int tree_sort(int arr_count, int arr[])
+{
+    return tree_sort_with_backend(arr_count, arr, CDSA_TREE_SORT_BACKEND_BST);
+}
+
+int tree_sort_with_backend(int arr_count, int arr[], int backend)
+{
+    switch (backend)
+    {
+    case CDSA_TREE_SORT_BACKEND_BST:
+        return tree_sort_bst(arr_count, arr);
+    case CDSA_TREE_SORT_BACKEND_AVL:
+        return tree_sort_avl(arr_count, arr);
+    case CDSA_TREE_SORT_BACKEND_BPLUS:
+        return tree_sort_bplus(arr_count, arr);
+    default:
+        fprintf(stderr, "Tree sort failed: unknown backend %d.\n", backend);
+        return CDSA_TREE_SORT_FAILED;
+    }
+}
+
+/* Sort input into output (which may be input itself) with the simple BST.
+ * arr_count is at least 2. */
+static int tree_sort_bst_into(
+    int arr_count,
+    const int input[],
+    int output[]
+)
+{
+    BST *tree;
+    int i;
+    int rc = CDSA_TREE_SORT_OK;
+    /*
+     * The number of nodes is known up front, so take them all from one arena.
+     * Fall back to allocating nodes one by one if that block is too large.
+     */
+    tree = new_bst_with_arena(arr_count);
+    if (tree == NULL) tree = new_bst();
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: failed to allocate tree.\n");
+        return CDSA_TREE_SORT_ALLOC_FAILED;
+    }
+    for (i = 0; i < arr_count; i++)
+    {
+        if (push_bst(tree, input[i]) != CDSA_TREE_SORT_OK)
+        {
+            fprintf(stderr, "Tree sort failed: failed to push to tree.\n");
+            rc = CDSA_TREE_SORT_FAILED;
+            goto cleanup_tree_sort;
+        }
+    }
+    tree_sort_in_order(output, tree->root);
+cleanup_tree_sort:
+    if (destroy_bst(&tree) != CDSA_TREE_SORT_OK)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: failed to destroy tree after using.\n"
+        );
+        return CDSA_TREE_SORT_FAILED;
+    }
+    return rc;
+}
+
+int tree_sort_bst(int arr_count, int arr[])
+{
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_TREE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_TREE_SORT_OK;
+    return tree_sort_bst_into(arr_count, arr, arr);
+}
+
+int tree_sort_partial(int arr_count, int arr[], int k)
+{
+    BST *tree;
+    int i, dropped, dropped_count;
+    int rc = CDSA_TREE_SORT_OK;
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_TREE_SORT_NULL;
+    }
+    if (k > arr_count) k = arr_count;
+    if (k <= 0) return CDSA_TREE_SORT_OK;
+    if (k == arr_count) return tree_sort_bst(arr_count, arr);
+    /* At most k + 1 nodes are ever in use, see push_bst_bounded(). */
+    tree = new_bst_with_arena(k + 1);
+    if (tree == NULL) tree = new_bst();
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: failed to allocate tree.\n");
+        return CDSA_TREE_SORT_ALLOC_FAILED;
+    }
+    /*
+     * Every element read drops at most one key, so the dropped keys can be
+     * stored over elements already read.
+     */
+    dropped_count = 0;
+    for (i = 0; i < arr_count; i++)
+    {
+        rc = push_bst_bounded(tree, arr[i], k, &dropped);
+        if (rc == CDSA_TREE_SORT_DROPPED)
+        {
+            arr[dropped_count++] = dropped;
+            rc = CDSA_TREE_SORT_OK;
+        }
+        else if (rc != CDSA_TREE_SORT_OK)
+        {
+            fprintf(stderr, "Tree sort failed: failed to push to tree.\n");
+            rc = CDSA_TREE_SORT_FAILED;
+            goto cleanup_tree_sort_partial;
+        }
+    }
+    /* The tree holds exactly k keys: move the others behind them. */
+    memmove(arr + k, arr, dropped_count * sizeof(int));
+    tree_sort_in_order(arr, tree->root);
+cleanup_tree_sort_partial:
+    if (destroy_bst(&tree) != CDSA_TREE_SORT_OK)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: failed to destroy tree after using.\n"
+        );
+        return CDSA_TREE_SORT_FAILED;
+    }
+    return rc;
+}
+
+static void tree_sort_avl_in_order(int arr[], AVLNode *node)
+{
+    AVLNode *predecessor;
+    int index = 0;
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            predecessor = node->left;
+            while (predecessor->right != NULL && predecessor->right != node)
+            {
+                predecessor = predecessor->right;
+            }
+            if (predecessor->right == NULL)
+            {
+                predecessor->right = node;
+                node = node->left;
+                continue;
+            }
+            predecessor->right = NULL;
+        }
+        arr[index++] = node->data;
+        node = node->right;
+    }
+}
+
+/* Sort input into output (which may be input itself) with an AVL tree.
+ * arr_count is at least 2. */
+static int tree_sort_avl_into(
+    int arr_count,
+    const int input[],
+    int output[]
+)
+{
+    AVLNode *nodes;
+    AVLNode *root = NULL;
+    int i;
+    nodes = malloc(arr_count * sizeof(AVLNode));
+    if (nodes == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: failed to allocate tree.\n");
+        return CDSA_TREE_SORT_ALLOC_FAILED;
+    }
+    CDSA_TREE_SORT_COUNT(allocations);
+    for (i = 0; i < arr_count; i++)
+    {
+        nodes[i].data = input[i];
+        insert_avl_node(&root, &nodes[i]);
+    }
+    tree_sort_avl_in_order(output, root);
+    free(nodes);
+    CDSA_TREE_SORT_COUNT(frees);
+    return CDSA_TREE_SORT_OK;
+}
+
+int tree_sort_avl(int arr_count, int arr[])
+{
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_TREE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_TREE_SORT_OK;
+    return tree_sort_avl_into(arr_count, arr, arr);
+}
+
+/* Sort input into output (which may be input itself) with a B+ tree. arr_count
+ * is at least 2. */
+static int tree_sort_bplus_into(
+    int arr_count,
+    const int input[],
+    int output[]
+)
+{
+    BPlusTree *tree;
+    BPlusTreeIterator iterator;
+    int i;
+    int rc = CDSA_TREE_SORT_OK;
+    tree = new_bplus_tree_with_arena(arr_count);
+    if (tree == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: failed to allocate tree.\n");
+        return CDSA_TREE_SORT_ALLOC_FAILED;
+    }
+    CDSA_TREE_SORT_COUNT(allocations);
+    for (i = 0; i < arr_count; i++)
+    {
+        if (push_bplus_tree(tree, input[i]) != CDSA_BPLUS_TREE_OK)
+        {
+            fprintf(stderr, "Tree sort failed: failed to push to tree.\n");
+            rc = CDSA_TREE_SORT_FAILED;
+            goto cleanup_tree_sort_bplus;
+        }
+    }
+    (void)begin_bplus_tree_iterator(tree, &iterator);
+    for (i = 0; i < arr_count; i++)
+    {
+        (void)next_bplus_tree_iterator(&iterator, &output[i]);
+    }
+cleanup_tree_sort_bplus:
+    (void)destroy_bplus_tree(&tree);
+    CDSA_TREE_SORT_COUNT(frees);
+    return rc;
+}
+
+int tree_sort_bplus(int arr_count, int arr[])
+{
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_TREE_SORT_NULL;
+    }
+    if (arr_count < 2) return CDSA_TREE_SORT_OK;
+    return tree_sort_bplus_into(arr_count, arr, arr);
+}
+
+/* Backend of a CDSA_TREE_SORT_BACKEND_* constant, or NULL if unknown. */
+static TreeSortInto tree_sort_backend_into(int backend)
+{
+    switch (backend)
+    {
+    case CDSA_TREE_SORT_BACKEND_BST:
+        return tree_sort_bst_into;
+    case CDSA_TREE_SORT_BACKEND_AVL:
+        return tree_sort_avl_into;
+    case CDSA_TREE_SORT_BACKEND_BPLUS:
+        return tree_sort_bplus_into;
+    default:
+        return NULL;
+    }
+}
+
+/* Bucket of a key: the number of splitters less than it, so that equal keys
+ * always land in the same bucket. */
+static int tree_sort_parallel_bucket(const TreeSortParallel *sort, int key)
+{
+    int low = 0, high = sort->bucket_count - 1, middle;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        if (sort->splitters[middle] < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+static void *tree_sort_parallel_work(void *arg)
+{
+    TreeSortWorker *worker = arg;
+    TreeSortParallel *sort = worker->sort;
+    int *offsets = sort->offsets + worker->id * sort->bucket_count;
+    int i, b, start, count;
+    switch (sort->phase)
+    {
+    case CDSA_TREE_SORT_PARALLEL_COUNT:
+        for (i = worker->start; i < worker->end; i++)
+        {
+            offsets[tree_sort_parallel_bucket(sort, sort->arr[i])] += 1;
+        }
+        break;
+    case CDSA_TREE_SORT_PARALLEL_SCATTER:
+        for (i = worker->start; i < worker->end; i++)
+        {
+            b = tree_sort_parallel_bucket(sort, sort->arr[i]);
+            sort->buffer[offsets[b]++] = sort->arr[i];
+        }
+        break;
+    case CDSA_TREE_SORT_PARALLEL_BUILD:
+        /* Each bucket is built in a tree of its own, with its own arena,
+         * and emitted in order right where it belongs in arr. */
+        b = worker->id;
+        start = sort->bucket_start[b];
+        count = sort->bucket_start[b + 1] - start;
+        if (count < 2)
+        {
+            if (count == 1) sort->arr[start] = sort->buffer[start];
+            break;
+        }
+        worker->rc = sort->sort_into(
+            count,
+            sort->buffer + start,
+            sort->arr + start
+        );
+        if (worker->rc != CDSA_TREE_SORT_OK)
+        {
+            /* Leave the bucket unsorted, but complete. */
+            memcpy(
+                sort->arr + start,
+                sort->buffer + start,
+                count * sizeof(int)
+            );
+        }
+        break;
+    default:
+        break;
+    }
+    return NULL;
+}
+
+/* Run the current phase on every worker, the calling thread being worker 0.
+ * A worker whose thread fails to start runs on the calling thread too. */
+static void tree_sort_parallel_run(
+    TreeSortParallel *sort,
+    TreeSortWorker *workers,
+    int phase
+)
+{
+    pthread_t threads[CDSA_TREE_SORT_PARALLEL_MAX_THREADS];
+    unsigned char started[CDSA_TREE_SORT_PARALLEL_MAX_THREADS];
+    int i;
+    sort->phase = phase;
+    for (i = 1; i < sort->bucket_count; i++)
+    {
+        started[i] = pthread_create(
+            &threads[i],
+            NULL,
+            tree_sort_parallel_work,
+            &workers[i]
+        ) == 0;
+    }
+    (void)tree_sort_parallel_work(&workers[0]);
+    for (i = 1; i < sort->bucket_count; i++)
+    {
+        if (started[i]) (void)pthread_join(threads[i], NULL);
+        else (void)tree_sort_parallel_work(&workers[i]);
+    }
+}
+
+/* Pick bucket_count - 1 splitters from a sorted, evenly spread sample of
+ * arr, so that the buckets get about the same number of keys. */
+static int tree_sort_parallel_split(TreeSortParallel *sort)
+{
+    int samples[
+        CDSA_TREE_SORT_PARALLEL_MAX_THREADS
+            * CDSA_TREE_SORT_PARALLEL_OVERSAMPLING
+    ];
+    int sample_count, stride, i, rc;
+    unsigned long x = 2463534242ul;
+    sample_count = sort->bucket_count * CDSA_TREE_SORT_PARALLEL_OVERSAMPLING;
+    stride = sort->arr_count / sample_count;
+    for (i = 0; i < sample_count; i++)
+    {
+        /* xorshift32 jitter within each stride, against periodic inputs */
+        x ^= (x << 13) & 0xFFFFFFFFul;
+        x ^= x >> 17;
+        x ^= (x << 5) & 0xFFFFFFFFul;
+        samples[i] = sort->arr[i * stride + (int)(x % (unsigned long)stride)];
+    }
+    /* AVL: the sample may well be sorted already. */
+    rc = tree_sort_avl_into(sample_count, samples, samples);
+    if (rc != CDSA_TREE_SORT_OK) return rc;
+    for (i = 1; i < sort->bucket_count; i++)
+    {
+        sort->splitters[i - 1] =
+            samples[i * CDSA_TREE_SORT_PARALLEL_OVERSAMPLING];
+    }
+    return CDSA_TREE_SORT_OK;
+}
+
+/* The parallel driver of tree_sort_parallel() and
+ * tree_sort_parallel_with_backend(), every bucket being sorted by
+ * sort_into. */
+static int tree_sort_parallel_into(
+    int arr_count,
+    int arr[],
+    int num_threads,
+    TreeSortInto sort_into
+)
+{
+    TreeSortParallel sort;
+    TreeSortWorker workers[CDSA_TREE_SORT_PARALLEL_MAX_THREADS];
+    int i, t, b, chunk, extra, bucket_count, total;
+    int rc = CDSA_TREE_SORT_OK;
+    if (arr == NULL)
+    {
+        fprintf(
+            stderr,
+            "Tree sort failed: invalid parameter: arr cannot be NULL.\n"
+        );
+        return CDSA_TREE_SORT_NULL;
+    }
+    bucket_count = num_threads;
+    if (bucket_count > CDSA_TREE_SORT_PARALLEL_MAX_THREADS)
+    {
+        bucket_count = CDSA_TREE_SORT_PARALLEL_MAX_THREADS;
+    }
+    if (bucket_count > arr_count / CDSA_TREE_SORT_PARALLEL_MIN_BUCKET)
+    {
+        bucket_count = arr_count / CDSA_TREE_SORT_PARALLEL_MIN_BUCKET;
+    }
+    if (bucket_count < 2)
+    {
+        if (arr_count < 2) return CDSA_TREE_SORT_OK;
+        return sort_into(arr_count, arr, arr);
+    }
+    sort.arr = arr;
+    sort.arr_count = arr_count;
+    sort.sort_into = sort_into;
+    sort.bucket_count = bucket_count;
+    sort.buffer = malloc(arr_count * sizeof(int));
+    sort.offsets = calloc(
+        (size_t)bucket_count * bucket_count,
+        sizeof(int)
+    );
+    if (sort.buffer != NULL) CDSA_TREE_SORT_COUNT(allocations);
+    if (sort.offsets != NULL) CDSA_TREE_SORT_COUNT(allocations);
+    if (sort.buffer == NULL || sort.offsets == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: failed to allocate buffer.\n");
+        rc = CDSA_TREE_SORT_ALLOC_FAILED;
+        goto cleanup_tree_sort_parallel;
+    }
+    rc = tree_sort_parallel_split(&sort);
+    if (rc != CDSA_TREE_SORT_OK) goto cleanup_tree_sort_parallel;
+    chunk = arr_count / bucket_count;
+    extra = arr_count % bucket_count;
+    for (t = 0; t < bucket_count; t++)
+    {
+        workers[t].sort = &sort;
+        workers[t].id = t;
+        workers[t].start = t * chunk + (t < extra ? t : extra);
+        workers[t].end = workers[t].start + chunk + (t < extra);
+        workers[t].rc = CDSA_TREE_SORT_OK;
+    }
+    tree_sort_parallel_run(&sort, workers, CDSA_TREE_SORT_PARALLEL_COUNT);
+    /* Per-worker counts to offsets: bucket b starts after the keys of all
+     * smaller buckets, and each worker scatters after the previous ones. */
+    total = 0;
+    for (b = 0; b < bucket_count; b++)
+    {
+        sort.bucket_start[b] = total;
+        for (t = 0; t < bucket_count; t++)
+        {
+            i = sort.offsets[t * bucket_count + b];
+            sort.offsets[t * bucket_count + b] = total;
+            total += i;
+        }
+    }
+    sort.bucket_start[bucket_count] = total;
+    tree_sort_parallel_run(&sort, workers, CDSA_TREE_SORT_PARALLEL_SCATTER);
+    tree_sort_parallel_run(&sort, workers, CDSA_TREE_SORT_PARALLEL_BUILD);
+    for (t = 0; t < bucket_count; t++)
+    {
+        if (workers[t].rc != CDSA_TREE_SORT_OK) rc = workers[t].rc;
+    }
+cleanup_tree_sort_parallel:
+    if (sort.buffer != NULL) CDSA_TREE_SORT_COUNT(frees);
+    if (sort.offsets != NULL) CDSA_TREE_SORT_COUNT(frees);
+    free(sort.buffer);
+    free(sort.offsets);
+    return rc;
+}
+
+int tree_sort_parallel(int arr_count, int arr[], int num_threads)
+{
+    /* Not the simple BST: every bucket of a presorted array would be
+     * sorted too, and quadratic. */
+    return tree_sort_parallel_into(
+        arr_count,
+        arr,
+        num_threads,
+        tree_sort_avl_into
+    );
+}
+
+int tree_sort_parallel_with_backend(
+    int arr_count,
+    int arr[],
+    int num_threads,
+    int backend
+)
+{
+    TreeSortInto sort_into = tree_sort_backend_into(backend);
+    if (sort_into == NULL)
+    {
+        fprintf(stderr, "Tree sort failed: unknown backend %d.\n", backend);
+        return CDSA_TREE_SORT_FAILED;
+    }
+    return tree_sort_parallel_into(arr_count, arr, num_threads, sort_into);
+}
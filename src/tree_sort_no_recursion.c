@@ -0,0 +1,66 @@
+/**
+ * @file tree_sort_no_recursion.c
+ * @author HN Thap
+ * @brief Aliases of the Tree sort functions of tree_sort.c under the
+ * tree_sort_no_recursion prefix.
+ * @version 0.1
+ * @date 2025-08-08
+ * @copyright See LICENSE
+ * 
+ * tree_sort.c walks and frees its trees without recursion, so every function
+ * here forwards to the tree_sort() function of the same suffix, which keeps
+ * a single copy of the BST, the B+ tree and the parallel driver. The module
+ * is not benchmarked on its own for the same reason.
+ */
+
+#include "tree_sort_no_recursion.h"
+
+int tree_sort_no_recursion(int arr_count, int arr[])
+{
+    return tree_sort(arr_count, arr);
+}
+
+int tree_sort_no_recursion_bst(int arr_count, int arr[])
+{
+    return tree_sort_bst(arr_count, arr);
+}
+
+int tree_sort_no_recursion_partial(int arr_count, int arr[], int k)
+{
+    return tree_sort_partial(arr_count, arr, k);
+}
+
+int tree_sort_no_recursion_avl(int arr_count, int arr[])
+{
+    return tree_sort_avl(arr_count, arr);
+}
+
+int tree_sort_no_recursion_bplus(int arr_count, int arr[])
+{
+    return tree_sort_bplus(arr_count, arr);
+}
+
+int tree_sort_no_recursion_with_backend(int arr_count, int arr[], int backend)
+{
+    return tree_sort_with_backend(arr_count, arr, backend);
+}
+
+int tree_sort_no_recursion_parallel(int arr_count, int arr[], int num_threads)
+{
+    return tree_sort_parallel(arr_count, arr, num_threads);
+}
+
+int tree_sort_no_recursion_parallel_with_backend(
+    int arr_count,
+    int arr[],
+    int num_threads,
+    int backend
+)
+{
+    return tree_sort_parallel_with_backend(
+        arr_count,
+        arr,
+        num_threads,
+        backend
+    );
+}